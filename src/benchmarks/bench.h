@@ -0,0 +1,39 @@
+#ifndef VIEWER_FRONT_SRC_BENCHMARKS_BENCH_H_
+#define VIEWER_FRONT_SRC_BENCHMARKS_BENCH_H_
+#include <benchmark/benchmark.h>
+#include <zlib.h>
+
+#include <cstdint>
+#include <string>
+
+#include "../controller/camera_controller.h"
+#include "../controller/obj_controller.h"
+#include "../model/bounding_box.h"
+#include "../model/camera_model.h"
+#include "../model/char_scanner.h"
+#include "../model/edge_extractor.h"
+#include "../model/mesh_cache.h"
+#include "../model/mesh_simplifier.h"
+#include "../model/number_parser.h"
+#include "../model/obj_model.h"
+#include "../model/thread_pool.h"
+#include "../model/triangulator.h"
+#include "../model/vertex_welder.h"
+#include "../tools/mesh_generator.h"
+
+/**
+ * @brief Возвращает количество байт, прочитанных процессом через read().
+ *
+ * Значение берётся из /proc/self/io (поле rchar); на системах без procfs
+ * возвращается 0.
+ */
+std::uint64_t ReadProcessBytes();
+
+/**
+ * @brief Создаёт во временном каталоге OBJ-файл с сеткой из треугольников.
+ *
+ * @param side Количество вершин по стороне сетки.
+ * @return std::string Путь к созданному файлу.
+ */
+std::string CreateGridObjFile(int side);
+#endif  // VIEWER_FRONT_SRC_BENCHMARKS_BENCH_H_
@@ -0,0 +1,43 @@
+#include "bench.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+std::uint64_t ReadProcessBytes() {
+  std::ifstream io("/proc/self/io");
+  std::string key{};
+  std::uint64_t value{};
+  while (io >> key >> value) {
+    if (key == "rchar:") return value;
+  }
+  return 0;
+}
+
+std::string CreateGridObjFile(int side) {
+  std::string path = (std::filesystem::temp_directory_path() /
+                      ("bench_grid_" + std::to_string(side) + ".obj"))
+                         .string();
+  std::ofstream file(path);
+  for (int y = 0; y < side; y++) {
+    for (int x = 0; x < side; x++) {
+      file << "v " << x * 0.01f << ' ' << y * 0.01f << ' '
+           << ((x * 7 + y * 13) % 17) * 0.001f << '\n';
+    }
+  }
+  for (int y = 0; y + 1 < side; y++) {
+    for (int x = 0; x + 1 < side; x++) {
+      int a = y * side + x + 1;
+      int b = a + 1;
+      int c = a + side;
+      int d = c + 1;
+      file << "f " << a << "/" << a << " " << b << "/" << b << " " << d << "/"
+           << d << '\n';
+      file << "f " << a << "/" << a << " " << d << "/" << d << " " << c << "/"
+           << c << '\n';
+    }
+  }
+  return path;
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "bench.h"
+
+static void BM_CameraMultiply(benchmark::State &state) {
+  s21::Mat4f a{}, b{}, result{};
+  for (int i = 0; i < 16; i++) {
+    a[i] = 0.25f * i - 1.0f;
+    b[i] = 1.0f / (i + 1);
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    result = a * b;
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CameraMultiply);
+
+static void BM_CalculateRotationMatrix(benchmark::State &state) {
+  s21::Camera camera;
+  float angle = 0.0f;
+
+  for (auto _ : state) {
+    angle = angle < 360.0f ? angle + 1.0f : 0.0f;
+    camera.calculateRotationMatrix(angle, 30.0f, 360.0f - angle);
+    benchmark::DoNotOptimize(camera.getRotataionMatrix());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculateRotationMatrix);
+
+// Одно событие перетаскивания мышью против пересчёта углов ползунками.
+static void BM_CameraOrbit(benchmark::State &state) {
+  s21::CameraController &camera = s21::CameraController::getInstance();
+  camera.calculateRotationMatrix(0.0f, 0.0f, 0.0f);
+  camera.beginOrbit(0.0f, 0.0f);
+  float x = 0.0f;
+
+  for (auto _ : state) {
+    x = x < 0.9f ? x + 0.001f : -0.9f;
+    camera.orbit(x, 0.5f * x);
+    benchmark::DoNotOptimize(camera.getRotataionMatrix());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CameraOrbit);
+
+// Полный пересчёт MVP, который выполняет каждый кадр отрисовки.
+static void BM_CameraFrameMvp(benchmark::State &state) {
+  s21::Controller shape =
+      s21::Controller::fromText("v -1 -1 -1\nv 1 1 1\nf 1 2 1\n");
+  s21::Camera camera;
+  camera.calculateModelMatrix(&shape);
+  camera.calculateViewMatrix();
+
+  for (auto _ : state) {
+    camera.calculateRotationMatrix(45.0f, 30.0f, 60.0f);
+    camera.multModelRotation();
+    camera.multMvpView();
+    camera.s21Frustum(1.5f, 45.0f, 0.1f, 100.0f);
+    camera.multMvpProjection();
+    benchmark::DoNotOptimize(camera.getMvpMatrix());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CameraFrameMvp);
+
+// Сдвиг ползунка и кадр: пересчитывается только левая пара матриц.
+static void BM_CameraSliderMvp(benchmark::State &state) {
+  s21::Controller shape =
+      s21::Controller::fromText("v -1 -1 -1\nv 1 1 1\nf 1 2 1\n");
+  s21::Camera camera;
+  camera.calculateModelMatrix(&shape);
+  camera.calculateViewMatrix();
+  camera.s21Frustum(1.5f, 45.0f, 0.1f, 100.0f);
+  camera.calculateRotationMatrix(45.0f, 30.0f, 60.0f);
+  float move = 0.0f;
+
+  for (auto _ : state) {
+    move = move < 1.0f ? move + 0.01f : 0.0f;
+    camera.setModelPosition(move, 0.0f, 0.0f);
+    benchmark::DoNotOptimize(camera.updateMvp());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CameraSliderMvp);
+
+static std::vector<float> TransformInput(std::size_t count) {
+  std::vector<float> points(count * 3);
+  for (std::size_t i = 0; i < points.size(); i++)
+    points[i] = static_cast<float>(i % 1021) * 0.001f - 0.5f;
+  return points;
+}
+
+// Камера вписывает куб [-0.5, 0.5], в котором лежат точки TransformInput,
+// поэтому все результаты конечны.
+static s21::CameraController &SetUpTransformCamera() {
+  s21::Controller shape =
+      s21::Controller::fromText("v -0.5 -0.5 -0.5\nv 0.5 0.5 0.5\nf 1 2 1\n");
+  s21::CameraController &camera = s21::CameraController::getInstance();
+  camera.calculateModelMatrix(&shape);
+  camera.setModelPosition(0.0f, 0.0f, 0.0f);
+  camera.calculateViewMatrix();
+  camera.s21Frustum(1.5f, 45.0f, 0.1f, 100.0f);
+  camera.calculateRotationMatrix(45.0f, 30.0f, 60.0f);
+  return camera;
+}
+
+static bool AllFinite(const std::vector<float> &values) {
+  return std::all_of(values.begin(), values.end(),
+                     [](float value) { return std::isfinite(value); });
+}
+
+// Перевод точек в координаты устройства: векторные ядра и общий пул.
+static void BM_TransformPoints(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range(0));
+  std::vector<float> points = TransformInput(count);
+  std::vector<float> out(points.size());
+  s21::CameraController &camera = SetUpTransformCamera();
+
+  for (auto _ : state) {
+    camera.transformPoints(points.data(), out.data(), count,
+                           s21::Camera::kDevice);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  if (!AllFinite(out)) state.SkipWithError("non-finite transform result");
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 24);
+}
+BENCHMARK(BM_TransformPoints)
+    ->Arg(1 << 20)
+    ->Arg(100000000)
+    ->Unit(benchmark::kMillisecond);
+
+// Та же работа по одной точке через Mat4f * Vec4f в одном потоке.
+static void BM_TransformPointsPerVector(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range(0));
+  std::vector<float> points = TransformInput(count);
+  std::vector<float> out(points.size());
+  s21::CameraController &camera = SetUpTransformCamera();
+  s21::Mat4f mvp;
+  std::copy(camera.updateMvp(), camera.updateMvp() + 16, mvp.m);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; i++) {
+      s21::Vec4f p = mvp * s21::Vec4f{points[i * 3], points[i * 3 + 1],
+                                      points[i * 3 + 2], 1.0f};
+      out[i * 3] = p.x / p.w;
+      out[i * 3 + 1] = p.y / p.w;
+      out[i * 3 + 2] = p.z / p.w;
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  if (!AllFinite(out)) state.SkipWithError("non-finite transform result");
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 24);
+}
+BENCHMARK(BM_TransformPointsPerVector)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
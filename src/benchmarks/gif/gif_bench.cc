@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <QBuffer>
+#include <QImage>
+#include <QPainter>
+#include <cstdint>
+#include <vector>
+
+#include "qgifimage.h"
+
+namespace {
+/**
+ * @brief Создаёт набор кадров, похожих на запись каркаса модели.
+ *
+ * Кадры детерминированы: на тёмном фоне рисуется поворачивающаяся сетка
+ * отрезков, как при записи GIF из окна просмотра.
+ *
+ * @param count Количество кадров.
+ * @param width Ширина кадра.
+ * @param height Высота кадра.
+ * @return std::vector<QImage> Кадры.
+ */
+std::vector<QImage> MakeFrames(int count, int width, int height) {
+  std::vector<QImage> frames{};
+  for (int frame = 0; frame < count; frame++) {
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(QColor(20, 20, 30));
+    QPainter painter(&image);
+    painter.translate(width / 2.0, height / 2.0);
+    painter.rotate(frame * 360.0 / count);
+    painter.setPen(QColor(120 + frame % 100, 200, 90));
+    for (int i = -20; i <= 20; i++) {
+      painter.drawLine(i * 10, -200, i * 10, 200);
+      painter.drawLine(-200, i * 10, 200, i * 10);
+    }
+    frames.push_back(image);
+  }
+  return frames;
+}
+}  // namespace
+
+// Запись GIF в приложении: кадр каждые 100 мс в течение 5 секунд.
+static void BM_GifSave(benchmark::State &state) {
+  std::vector<QImage> frames =
+      MakeFrames(50, static_cast<int>(state.range(0)),
+                 static_cast<int>(state.range(1)));
+  QGifImage gif;
+  gif.setDefaultDelay(100);
+  for (const QImage &frame : frames) gif.addFrame(frame);
+
+  std::int64_t bytes = 0;
+  for (auto _ : state) {
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    if (!gif.save(&buffer)) state.SkipWithError("QGifImage::save failed");
+    bytes = buffer.size();
+  }
+
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(frames.size()));
+  state.counters["gif_bytes"] = static_cast<double>(bytes);
+}
+BENCHMARK(BM_GifSave)->Args({640, 480})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+#include "bench.h"
+
+static void BM_ModelParse(benchmark::State &state) {
+  std::string path = CreateGridObjFile(static_cast<int>(state.range(0)));
+  auto fileSize = std::filesystem::file_size(path);
+  std::uint64_t readBytes{};
+  s21::ParseOptions options;
+  options.threads = static_cast<unsigned int>(state.range(1));
+
+  for (auto _ : state) {
+    std::uint64_t before = ReadProcessBytes();
+    s21::Model model(path, options);
+    readBytes += ReadProcessBytes() - before;
+    benchmark::DoNotOptimize(model.getVertexes().data());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * fileSize));
+  state.counters["file_bytes"] = static_cast<double>(fileSize);
+  state.counters["read_passes"] =
+      static_cast<double>(readBytes) / (fileSize * state.iterations());
+  std::filesystem::remove(path);
+}
+// Второй аргумент - число потоков разбора (0 - по числу ядер).
+BENCHMARK(BM_ModelParse)
+    ->Args({64, 0})
+    ->Args({256, 0})
+    ->Args({1024, 1})
+    ->Args({1024, 0})
+    ->Unit(benchmark::kMillisecond);
+
+// Первый аргумент - форма MeshGenerator::Shape, второй - число граней.
+static void BM_ModelParseGenerated(benchmark::State &state) {
+  auto shape = static_cast<s21::MeshGenerator::Shape>(state.range(0));
+  std::string path = (std::filesystem::temp_directory_path() /
+                      ("bench_generated_" + std::to_string(state.range(0)) +
+                       ".obj"))
+                         .string();
+  s21::MeshGenerator::writeFile(path, shape,
+                                static_cast<std::uint64_t>(state.range(1)), 1);
+  auto fileSize = std::filesystem::file_size(path);
+
+  for (auto _ : state) {
+    s21::Model model(path);
+    benchmark::DoNotOptimize(model.getVertexes().data());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * fileSize));
+  state.counters["file_bytes"] = static_cast<double>(fileSize);
+  std::filesystem::remove(path);
+}
+BENCHMARK(BM_ModelParseGenerated)
+    ->Args({s21::MeshGenerator::kSphere, 1 << 20})
+    ->Args({s21::MeshGenerator::kTerrain, 1 << 20})
+    ->Args({s21::MeshGenerator::kSoup, 1 << 20})
+    ->Args({s21::MeshGenerator::kCloud, 1 << 20})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_ModelParseGzip(benchmark::State &state) {
+  std::string path = CreateGridObjFile(static_cast<int>(state.range(0)));
+  auto fileSize = std::filesystem::file_size(path);
+  std::string packed = path + ".gz";
+  {
+    std::ifstream file(path, std::ios::binary);
+    std::string text((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+    gzFile gz = gzopen(packed.c_str(), "wb6");
+    gzwrite(gz, text.data(), static_cast<unsigned>(text.size()));
+    gzclose(gz);
+  }
+
+  for (auto _ : state) {
+    s21::Model model(packed);
+    benchmark::DoNotOptimize(model.getVertexes().data());
+  }
+
+  // Пропускная способность считается по распакованному тексту.
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * fileSize));
+  state.counters["packed_bytes"] =
+      static_cast<double>(std::filesystem::file_size(packed));
+  std::filesystem::remove(packed);
+  std::filesystem::remove(path);
+}
+BENCHMARK(BM_ModelParseGzip)->Arg(256)->Arg(1024)->Unit(
+    benchmark::kMillisecond);
+
+static void BM_ModelParseCached(benchmark::State &state) {
+  std::string path = CreateGridObjFile(static_cast<int>(state.range(0)));
+  auto fileSize = std::filesystem::file_size(path);
+  s21::ParseOptions options;
+  options.useCache = true;
+  { s21::Model warmup(path, options); }
+
+  for (auto _ : state) {
+    s21::Model model(path, options);
+    benchmark::DoNotOptimize(model.getVertexes().data());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * fileSize));
+  std::filesystem::remove(s21::MeshCache::cachePath(path));
+  std::filesystem::remove(path);
+}
+BENCHMARK(BM_ModelParseCached)->Arg(256)->Arg(1024)->Unit(
+    benchmark::kMillisecond);
+
+namespace {
+std::vector<std::string> MakeVertexLines(int count) {
+  std::vector<std::string> lines{};
+  for (int i = 0; i < count; i++) {
+    lines.push_back("v " + std::to_string(i * 0.0137f - 20.0f) + " " +
+                    std::to_string(i * -0.021f) + " " +
+                    std::to_string((i % 97) * 1.5f));
+  }
+  return lines;
+}
+}  // namespace
+
+// Прежний способ: std::stringstream по копии строки и std::stof на токен.
+static void BM_VertexLineStringstream(benchmark::State &state) {
+  auto lines = MakeVertexLines(4096);
+  for (auto _ : state) {
+    for (const auto &line : lines) {
+      std::stringstream ss(line.substr(2));
+      std::string tmp;
+      float sum{};
+      while (ss >> tmp) sum += std::stof(tmp);
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+  state.counters["vertices"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * lines.size()),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_VertexLineStringstream);
+
+static void BM_VertexLineNumberParser(benchmark::State &state) {
+  auto lines = MakeVertexLines(4096);
+  for (auto _ : state) {
+    for (const auto &line : lines) {
+      const char *cursor = line.data() + 2;
+      const char *end = line.data() + line.size();
+      float sum{};
+      for (int i = 0; i < 3; i++) {
+        while (cursor < end && *cursor == ' ') cursor++;
+        float value{};
+        s21::NumberParser::parseFloat(cursor, end, value);
+        sum += value;
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+  state.counters["vertices"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * lines.size()),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_VertexLineNumberParser);
+
+// Построение масок разделителей для текста граней; аргумент -
+// CharScanner::Isa.
+static void BM_CharScannerFaces(benchmark::State &state) {
+  auto isa = static_cast<s21::CharScanner::Isa>(state.range(0));
+  if (!s21::CharScanner::supported(isa)) {
+    state.SkipWithError("instruction set is not supported");
+    return;
+  }
+  std::string text{};
+  for (int i = 1; text.size() < (std::size_t{1} << 22); i++) {
+    text += "f " + std::to_string(i) + "/" + std::to_string(i) + "/1 " +
+            std::to_string(i + 1) + "//2 " + std::to_string(i + 2) + "\n";
+  }
+  const char *end = text.data() + text.size();
+
+  for (auto _ : state) {
+    std::size_t tokens{};
+    for (const char *block = text.data(); block < end;
+         block += s21::CharScanner::kBlockSize) {
+      std::size_t size = std::min<std::size_t>(end - block, 64);
+      auto masks = s21::CharScanner::scan(block, size, isa);
+      tokens += __builtin_popcountll(masks.newline | masks.space | masks.slash);
+    }
+    benchmark::DoNotOptimize(tokens);
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_CharScannerFaces)
+    ->Arg(s21::CharScanner::kScalar)
+    ->Arg(s21::CharScanner::kSse2)
+    ->Arg(s21::CharScanner::kAvx2);
+
+namespace {
+// Контуры сетки side x side квадратов и координаты её вершин.
+std::vector<int> MakeQuadOutlines(int side, std::vector<float> *vertexes) {
+  std::vector<int> outlines{};
+  for (int y = 0; y < side; y++) {
+    for (int x = 0; x < side; x++) {
+      int v = y * (side + 1) + x;
+      int up = v + side + 1;
+      outlines.insert(outlines.end(), {v, v + 1, up + 1, up, -1});
+    }
+  }
+  if (vertexes != nullptr) {
+    for (int y = 0; y <= side; y++) {
+      for (int x = 0; x <= side; x++) {
+        vertexes->insert(vertexes->end(),
+                         {(float)x, (float)y, (float)((x * y) % 7)});
+      }
+    }
+  }
+  return outlines;
+}
+}  // namespace
+
+// Выделение уникальных рёбер сетки side x side квадратов; счётчик
+// line_ratio - доля растеризуемых рёбер по сравнению с отрисовкой
+// контуров каждой грани (4 ребра на квадрат).
+static void BM_EdgeExtract(benchmark::State &state) {
+  int side = static_cast<int>(state.range(0));
+  std::vector<int> outlines = MakeQuadOutlines(side, nullptr);
+  std::size_t lineCount{};
+
+  for (auto _ : state) {
+    std::vector<int> lines =
+        s21::EdgeExtractor::extract(outlines, s21::ThreadPool::shared());
+    lineCount = lines.size() / 2;
+    benchmark::DoNotOptimize(lines.data());
+  }
+
+  double faces = static_cast<double>(side) * side;
+  state.counters["faces"] = benchmark::Counter(
+      state.iterations() * faces, benchmark::Counter::kIsRate);
+  state.counters["line_ratio"] = static_cast<double>(lineCount) / (faces * 4);
+}
+BENCHMARK(BM_EdgeExtract)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_Triangulate(benchmark::State &state) {
+  std::vector<float> vertexes{};
+  std::vector<int> outlines =
+      MakeQuadOutlines(static_cast<int>(state.range(0)), &vertexes);
+
+  for (auto _ : state) {
+    std::vector<int> triangles = s21::Triangulator::triangulate(
+        outlines, vertexes, s21::ThreadPool::shared());
+    benchmark::DoNotOptimize(triangles.data());
+  }
+
+  state.counters["faces"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * outlines.size() / 5),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Triangulate)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_BoundingBox(benchmark::State &state) {
+  std::vector<float> vertexes(static_cast<std::size_t>(state.range(0)) * 3);
+  for (std::size_t i = 0; i < vertexes.size(); i++)
+    vertexes[i] = static_cast<float>((i * 2654435761u) % 100003) * 0.01f;
+
+  for (auto _ : state) {
+    s21::BoundingBox box =
+        s21::BoundingBox::compute(vertexes.data(), vertexes.size() / 3);
+    benchmark::DoNotOptimize(box);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(
+      state.iterations() * vertexes.size() * sizeof(float)));
+}
+BENCHMARK(BM_BoundingBox)->Arg(1 << 20);
+
+// Сварка сетки side x side квадратов, у каждого из которых свои четыре
+// вершины; второй аргумент - допуск в миллионных (0 - точные совпадения).
+static void BM_VertexWeld(benchmark::State &state) {
+  int side = static_cast<int>(state.range(0));
+  float tolerance = static_cast<float>(state.range(1)) * 1e-6f;
+  std::vector<float> grid{};
+  std::vector<int> shared = MakeQuadOutlines(side, &grid);
+  std::vector<float> vertexes{};
+  std::vector<int> outlines{};
+  for (int index : shared) {
+    if (index < 0) {
+      outlines.push_back(index);
+      continue;
+    }
+    outlines.push_back(static_cast<int>(vertexes.size() / 3));
+    vertexes.insert(vertexes.end(), grid.begin() + index * 3,
+                    grid.begin() + index * 3 + 3);
+  }
+  s21::WeldStats stats{};
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<float> welded = vertexes;
+    std::vector<int> indexes = outlines;
+    state.ResumeTiming();
+    stats = s21::VertexWelder::weld(welded, indexes, tolerance,
+                                    s21::ThreadPool::shared());
+    benchmark::DoNotOptimize(welded.data());
+  }
+
+  state.counters["vertexes"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * stats.vertexesBefore),
+      benchmark::Counter::kIsRate);
+  state.counters["saved_bytes"] = static_cast<double>(stats.savedBytes);
+}
+BENCHMARK(BM_VertexWeld)
+    ->Args({512, 0})
+    ->Args({512, 100})
+    ->Unit(benchmark::kMillisecond);
+
+// Упрощение сетки side x side квадратов (2 * side^2 треугольников) до 10%;
+// счётчик triangles - скорость по треугольникам входа.
+static void BM_MeshSimplify(benchmark::State &state) {
+  std::vector<float> vertexes{};
+  std::vector<int> outlines =
+      MakeQuadOutlines(static_cast<int>(state.range(0)), &vertexes);
+  std::vector<int> triangles = s21::Triangulator::triangulate(
+      outlines, vertexes, s21::ThreadPool::shared());
+  std::size_t kept{};
+
+  for (auto _ : state) {
+    s21::MeshLod lod = s21::MeshSimplifier::simplify(
+        vertexes, triangles, triangles.size() / 30, s21::ThreadPool::shared());
+    kept = lod.triangles.size();
+    benchmark::DoNotOptimize(lod.triangles.data());
+  }
+
+  state.counters["triangles"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * triangles.size() / 3),
+      benchmark::Counter::kIsRate);
+  state.counters["kept_ratio"] =
+      static_cast<double>(kept) / static_cast<double>(triangles.size());
+}
+BENCHMARK(BM_MeshSimplify)->Arg(512)->Unit(benchmark::kMillisecond);
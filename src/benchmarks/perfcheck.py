@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""Сравнивает результаты Google Benchmark с сохранённым эталоном.
+
+Для каждого замера берётся медиана пропускной способности по повторам и
+медианное абсолютное отклонение (MAD). Замер считается регрессией, только
+если медиана упала больше чем на порог И падение превышает шум, то есть
+несколько робастных сигм (1.4826 * MAD) эталона или текущего прогона.
+Замер без эталона и эталон без замера (например, после переименования)
+тоже проваливают проверку: эталон нужно перезаписать через --update.
+
+    perfcheck.py current.json baseline.json [--threshold 0.10]
+    perfcheck.py current.json baseline.json --update
+"""
+
+import argparse
+import json
+import statistics
+import sys
+
+# Коэффициент перехода от MAD к стандартному отклонению для нормального
+# распределения.
+MAD_TO_SIGMA = 1.4826
+
+
+def throughput(run):
+    """Пропускная способность одного повтора: больше - лучше."""
+    for key in ("bytes_per_second", "items_per_second"):
+        if key in run:
+            return key, float(run[key])
+    return "runs_per_second", 1.0 / float(run["real_time"])
+
+
+def summarize(report):
+    """Медиана и MAD по повторам каждого замера."""
+    samples = {}
+    metrics = {}
+    for run in report["benchmarks"]:
+        if run.get("run_type", "iteration") != "iteration":
+            continue
+        if run.get("error_occurred"):
+            continue
+        name = run.get("run_name", run["name"])
+        metric, value = throughput(run)
+        samples.setdefault(name, []).append(value)
+        metrics[name] = metric
+    summary = {}
+    for name, values in samples.items():
+        median = statistics.median(values)
+        mad = statistics.median(abs(value - median) for value in values)
+        summary[name] = {
+            "metric": metrics[name],
+            "median": median,
+            "mad": mad,
+            "repetitions": len(values),
+        }
+    return summary
+
+
+def compare(current, baseline, threshold, noise):
+    """Имена замеров, которые регрессировали или не сопоставлены."""
+    regressions = []
+    print(f"{'benchmark':<44} {'baseline':>12} {'current':>12} {'change':>8}")
+    for name in sorted(current):
+        now = current[name]
+        if name not in baseline:
+            print(f"{name:<44} {'-':>12} {now['median']:>12.4g}  "
+                  "MISSING BASELINE")
+            regressions.append(name)
+            continue
+        base = baseline[name]
+        change = now["median"] / base["median"] - 1.0
+        sigma = MAD_TO_SIGMA * max(now["mad"], base["mad"])
+        drop = base["median"] - now["median"]
+        regressed = change < -threshold and drop > noise * sigma
+        mark = "  REGRESSION" if regressed else ""
+        print(f"{name:<44} {base['median']:>12.4g} {now['median']:>12.4g} "
+              f"{change:>+7.1%}{mark}")
+        if regressed:
+            regressions.append(name)
+    for name in sorted(set(baseline) - set(current)):
+        print(f"{name:<44} MISSING from the current run")
+        regressions.append(name)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("current", help="JSON from --benchmark_out")
+    parser.add_argument("baseline", help="checked-in baseline JSON")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed median throughput drop (0.10 = 10%%)")
+    parser.add_argument("--noise", type=float, default=3.0,
+                        help="drop must also exceed this many MAD sigmas")
+    parser.add_argument("--update", action="store_true",
+                        help="overwrite the baseline with the current run")
+    args = parser.parse_args()
+
+    with open(args.current, encoding="utf-8") as file:
+        report = json.load(file)
+    current = summarize(report)
+    if not current:
+        print("perfcheck: no benchmark results in " + args.current)
+        return 1
+
+    if args.update:
+        with open(args.baseline, "w", encoding="utf-8") as file:
+            json.dump({"context": report.get("context", {}),
+                       "benchmarks": current}, file, indent=2, sort_keys=True)
+            file.write("\n")
+        print(f"perfcheck: baseline {args.baseline} updated")
+        return 0
+
+    with open(args.baseline, encoding="utf-8") as file:
+        baseline = json.load(file)["benchmarks"]
+    regressions = compare(current, baseline, args.threshold, args.noise)
+    if regressions:
+        print(f"perfcheck: {len(regressions)} benchmark(s) regressed by more "
+              f"than {args.threshold:.0%} or have no matching baseline entry")
+        return 1
+    print("perfcheck: OK")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,5 +1,6 @@
 #include "camera_controller.h"
 
+#include "../model/thread_pool.h"
 #include "obj_controller.h"
 
 s21::CameraController::CameraController() : cameraModel() {}
@@ -21,15 +22,43 @@ float *s21::CameraController::getRotataionMatrix() {
 void s21::CameraController::calculateModelMatrix(s21::Controller *shape) {
   cameraModel.calculateModelMatrix(shape);
 }
+void s21::CameraController::calculateModelMatrix(const Vec3f &min,
+                                                 const Vec3f &max) {
+  cameraModel.calculateModelMatrix(min, max);
+}
 void s21::CameraController::setModelPosition(float x, float y, float z) {
   cameraModel.setModelPosition(x, y, z);
 }
+s21::Vec3f s21::CameraController::getModelPosition() const {
+  return cameraModel.getModelPosition();
+}
 void s21::CameraController::setModelScale(float scale) {
   cameraModel.setModelScale(scale);
 }
 void s21::CameraController::calculateRotationMatrix(float xAngle, float yAngle,
                                                     float zAngle) {
   cameraModel.calculateRotationMatrix(xAngle, yAngle, zAngle);
+  orientation = s21::Camera::eulerRotation(xAngle, yAngle, zAngle);
+}
+void s21::CameraController::beginOrbit(float x, float y) {
+  orbitPoint = s21::Camera::arcballPoint(x, y);
+}
+void s21::CameraController::orbit(float x, float y) {
+  s21::Vec4f point = s21::Camera::arcballPoint(x, y);
+  s21::Quat q = s21::Camera::arc(orbitPoint, point) * orientation;
+  // Произведение единичных кватернионов отличается от единичного лишь
+  // ошибкой округления; шаг Ньютона для 1/|q| убирает её без корня
+  // и деления, не давая ошибке копиться от события к событию.
+  float scale = 1.5f - 0.5f * (q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+  orientation = s21::Quat{q.w * scale, q.x * scale, q.y * scale, q.z * scale};
+  orbitPoint = point;
+  cameraModel.setRotation(orientation);
+}
+void s21::CameraController::pan(float dx, float dy) {
+  cameraModel.translateModel(dx, dy);
+}
+void s21::CameraController::zoom(float factor) {
+  cameraModel.scaleModel(factor);
 }
 void s21::CameraController::s21Frustum(float aspect, float fov, float near,
                                        float far) {
@@ -42,6 +71,14 @@ void s21::CameraController::s21Ortho(float aspect, float fov, float near,
 void s21::CameraController::calculateViewMatrix() {
   cameraModel.calculateViewMatrix();
 }
+const float *s21::CameraController::updateMvp() {
+  return cameraModel.updateMvp();
+}
+void s21::CameraController::transformPoints(const float *in, float *out,
+                                            std::size_t count,
+                                            Camera::Space space) {
+  cameraModel.transformPoints(in, out, count, space, ThreadPool::shared());
+}
 void s21::CameraController::multModelRotation() {
   cameraModel.multModelRotation();
 }
@@ -49,13 +86,13 @@ void s21::CameraController::multMvpView() { cameraModel.multMvpView(); }
 void s21::CameraController::multMvpProjection() {
   cameraModel.multMvpProjection();
 }
-Vec4 s21::CameraController::cross(Vec4 a, Vec4 b) {
+s21::Vec4f s21::CameraController::cross(s21::Vec4f a, s21::Vec4f b) {
   return s21::Camera::cross(a, b);
 }
-Vec4 s21::CameraController::normalize(Vec4 v) {
+s21::Vec4f s21::CameraController::normalize(s21::Vec4f v) {
   return s21::Camera::normalize(v);
 }
-Vec4 s21::CameraController::subtract(Vec4 a, Vec4 b) {
+s21::Vec4f s21::CameraController::subtract(s21::Vec4f a, s21::Vec4f b) {
   return s21::Camera::subtract(a, b);
 }
 s21::CameraController &s21::CameraController::getInstance() {
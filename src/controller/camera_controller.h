@@ -66,6 +66,13 @@ class CameraController {
    */
   void calculateModelMatrix(s21::Controller *shape);
 
+  /**
+   * @brief Вписывает границы модели в область просмотра.
+   * @param min Наименьшие координаты модели.
+   * @param max Наибольшие координаты модели.
+   */
+  void calculateModelMatrix(const Vec3f &min, const Vec3f &max);
+
   /**
    * @brief Устанавливает положение модели.
    * @param x Координата X.
@@ -74,6 +81,12 @@ class CameraController {
    */
   void setModelPosition(float x, float y, float z);
 
+  /**
+   * @brief Получает положение модели в координатах setModelPosition.
+   * @return Положение центра модели.
+   */
+  Vec3f getModelPosition() const;
+
   /**
    * @brief Устанавливает масштаб модели.
    * @param scale Значение масштаба.
@@ -82,12 +95,48 @@ class CameraController {
 
   /**
    * @brief Вычисляет матрицу вращения по углам.
+   *
+   * Задаёт и ориентацию виртуального шара, так что вращение мышью
+   * продолжается от положения ползунков.
+   *
    * @param xAngle Угол вращения по оси X.
    * @param yAngle Угол вращения по оси Y.
    * @param zAngle Угол вращения по оси Z.
    */
   void calculateRotationMatrix(float xAngle, float yAngle, float zAngle);
 
+  /**
+   * @brief Начинает вращение виртуальным шаром.
+   * @param x Горизонтальная координата курсора в [-1, 1].
+   * @param y Вертикальная координата курсора в [-1, 1].
+   */
+  void beginOrbit(float x, float y);
+
+  /**
+   * @brief Поворачивает модель за курсором.
+   *
+   * К ориентации прибавляется только поворот от прошлой точки шара
+   * к текущей: одно произведение кватернионов и заполнение матрицы
+   * вращения.
+   *
+   * @param x Горизонтальная координата курсора в [-1, 1].
+   * @param y Вертикальная координата курсора в [-1, 1].
+   */
+  void orbit(float x, float y);
+
+  /**
+   * @brief Сдвигает модель за курсором.
+   * @param dx Сдвиг курсора по горизонтали в координатах [-1, 1].
+   * @param dy Сдвиг курсора по вертикали в координатах [-1, 1].
+   */
+  void pan(float dx, float dy);
+
+  /**
+   * @brief Приближает или отдаляет модель.
+   * @param factor Множитель масштаба; больше 1 - приближение.
+   */
+  void zoom(float factor);
+
   /**
    * @brief Создает матрицу перспективной проекции с использованием frustum.
    * @param aspect Соотношение сторон экрана.
@@ -111,6 +160,27 @@ class CameraController {
    */
   void calculateViewMatrix();
 
+  /**
+   * @brief Пересчитывает изменившиеся звенья MVP.
+   * @return Матрица MVP по строкам (const float*).
+   */
+  const float *updateMvp();
+
+  /**
+   * @brief Применяет текущие матрицы к массиву точек на процессоре.
+   *
+   * Нужен для выбора точек мышью, экспорта преобразованной модели и
+   * проверки видимости границ; блоки точек обрабатываются общим пулом
+   * потоков.
+   *
+   * @param in Координаты точек, по три на точку.
+   * @param out Преобразованные координаты; может совпадать с in.
+   * @param count Количество точек.
+   * @param space Camera::kModel или Camera::kDevice.
+   */
+  void transformPoints(const float *in, float *out, std::size_t count,
+                       Camera::Space space);
+
   /**
    * @brief Применяет матрицу вращения к модели.
    */
@@ -130,24 +200,24 @@ class CameraController {
    * @brief Вычисляет векторное произведение двух векторов.
    * @param a Первый вектор.
    * @param b Второй вектор.
-   * @return Векторное произведение (Vec4).
+   * @return Векторное произведение (Vec4f).
    */
-  static Vec4 cross(Vec4 a, Vec4 b);
+  static Vec4f cross(Vec4f a, Vec4f b);
 
   /**
    * @brief Нормализует вектор.
    * @param v Вектор для нормализации.
-   * @return Нормализованный вектор (Vec4).
+   * @return Нормализованный вектор (Vec4f).
    */
-  static Vec4 normalize(Vec4 v);
+  static Vec4f normalize(Vec4f v);
 
   /**
    * @brief Вычитает один вектор из другого.
    * @param a Вектор уменьшаемый.
    * @param b Вектор вычитаемый.
-   * @return Результат вычитания (Vec4).
+   * @return Результат вычитания (Vec4f).
    */
-  static Vec4 subtract(Vec4 a, Vec4 b);
+  static Vec4f subtract(Vec4f a, Vec4f b);
 
  private:
   /**
@@ -156,7 +226,9 @@ class CameraController {
    */
   CameraController();
 
-  s21::Camera cameraModel;  ///< Экземпляр камеры.
+  s21::Camera cameraModel;        ///< Экземпляр камеры.
+  Quat orientation{1, 0, 0, 0};  ///< Текущее вращение модели.
+  Vec4f orbitPoint{0, 0, 1, 0};   ///< Прошлая точка виртуального шара.
 };
 }  // namespace s21
 
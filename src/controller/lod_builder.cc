@@ -0,0 +1,49 @@
+#include "lod_builder.h"
+
+#include "../model/thread_pool.h"
+
+s21::LodBuilder::LodBuilder(std::shared_ptr<Controller> model,
+                            std::vector<float> ratios, unsigned int threads)
+    : model_(std::move(model)),
+      ratios_(std::move(ratios)),
+      threads_(threads),
+      progress_(),
+      result_(),
+      error_(),
+      finished_(false) {
+  worker_ = std::thread(&LodBuilder::run, this);
+}
+
+s21::LodBuilder::~LodBuilder() {
+  progress_.cancel();
+  if (worker_.joinable()) worker_.join();
+}
+
+const std::shared_ptr<s21::Controller> &s21::LodBuilder::getModel() const {
+  return model_;
+}
+
+double s21::LodBuilder::getProgress() const { return progress_.fraction(); }
+
+bool s21::LodBuilder::isFinished() const {
+  return finished_.load(std::memory_order_acquire);
+}
+
+void s21::LodBuilder::cancel() { progress_.cancel(); }
+
+std::vector<s21::MeshLod> s21::LodBuilder::takeResult() {
+  if (worker_.joinable()) worker_.join();
+  if (error_) std::rethrow_exception(error_);
+  return std::move(result_);
+}
+
+void s21::LodBuilder::run() {
+  try {
+    ThreadPool pool(threads_);
+    result_ = MeshSimplifier::buildChain(
+        model_->getVertexes(), model_->getEdges(), ratios_, pool, &progress_);
+  } catch (...) {
+    error_ = std::current_exception();
+  }
+  finished_.store(true, std::memory_order_release);
+}
@@ -0,0 +1,93 @@
+#ifndef LOD_BUILDER_H_
+#define LOD_BUILDER_H_
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../model/load_progress.h"
+#include "../model/mesh_simplifier.h"
+#include "obj_controller.h"
+
+namespace s21 {
+/**
+ * @class LodBuilder
+ * @brief Строит цепочку уровней детализации модели в фоновом потоке.
+ *
+ * Упрощение идёт в собственном пуле потоков, поэтому не задерживает
+ * загрузку следующей модели в общем пуле. Интерфейс опрашивает
+ * готовность и забирает уровни через takeResult() в своём потоке.
+ */
+class LodBuilder {
+ public:
+  /**
+   * @brief Запускает построение уровней.
+   * @param model Загруженная модель; удерживается до конца построения.
+   * @param ratios Доли треугольников уровней по убыванию.
+   * @param threads Число потоков упрощения; 0 - по числу аппаратных.
+   */
+  explicit LodBuilder(std::shared_ptr<Controller> model,
+                      std::vector<float> ratios =
+                          MeshSimplifier::defaultRatios(),
+                      unsigned int threads = 0);
+
+  /**
+   * @brief Отменяет незавершённое построение и дожидается фонового
+   * потока.
+   */
+  ~LodBuilder();
+
+  LodBuilder(const LodBuilder &) = delete;
+  LodBuilder &operator=(const LodBuilder &) = delete;
+
+  /**
+   * @brief Возвращает модель, для которой строятся уровни.
+   * @return Контроллер модели (const std::shared_ptr<Controller>&).
+   */
+  [[nodiscard]] const std::shared_ptr<Controller> &getModel() const;
+
+  /**
+   * @brief Возвращает долю построенных уровней.
+   * @return Значение от 0 до 1 (double).
+   */
+  [[nodiscard]] double getProgress() const;
+
+  /**
+   * @brief Проверяет, завершилось ли построение.
+   * @return true, если можно вызывать takeResult().
+   */
+  [[nodiscard]] bool isFinished() const;
+
+  /**
+   * @brief Запрашивает отмену построения.
+   */
+  void cancel();
+
+  /**
+   * @brief Забирает построенные уровни.
+   *
+   * Дожидается завершения фонового потока. Если построение завершилось
+   * ошибкой или было отменено, пробрасывает исключение (LoadCancelled).
+   *
+   * @return Уровни от подробного к грубому (std::vector<MeshLod>).
+   */
+  std::vector<MeshLod> takeResult();
+
+ private:
+  /**
+   * @brief Тело фонового потока.
+   */
+  void run();
+
+  std::shared_ptr<Controller> model_;  ///< Упрощаемая модель.
+  std::vector<float> ratios_;          ///< Доли треугольников уровней.
+  unsigned int threads_;               ///< Число потоков упрощения.
+  LoadProgress progress_;              ///< Прогресс и отмена.
+  std::vector<MeshLod> result_;        ///< Построенные уровни.
+  std::exception_ptr error_;           ///< Ошибка построения.
+  std::atomic<bool> finished_;         ///< Признак завершения потока.
+  std::thread worker_;                 ///< Фоновый поток.
+};
+}  // namespace s21
+#endif  // LOD_BUILDER_H_
@@ -0,0 +1,123 @@
+#include "lod_selector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/// Шаг изменения множителя допуска за кадр.
+constexpr float kScaleStep = 1.25f;
+/// Доля целевого времени, ниже которой допуск начинает уменьшаться.
+constexpr double kFastFrame = 0.6;
+
+void project(const float *mvp, const float point[3], float clip[4]) {
+  for (int row = 0; row < 4; row++) {
+    clip[row] = mvp[row * 4] * point[0] + mvp[row * 4 + 1] * point[1] +
+                mvp[row * 4 + 2] * point[2] + mvp[row * 4 + 3];
+  }
+}
+}  // namespace
+
+s21::LodSelector::LodSelector()
+    : errors_{0.0f},
+      sizes_(),
+      interactive_(false),
+      budget_(0),
+      current_(0),
+      tolerance_(kDefaultTolerance),
+      scale_(1.0f),
+      targetFrameTime_(1000.0 / 30.0) {}
+
+void s21::LodSelector::setLevels(std::vector<float> errors,
+                                 std::vector<std::size_t> sizes) {
+  errors_ = std::move(errors);
+  sizes_ = std::move(sizes);
+  if (errors_.empty()) errors_.push_back(0.0f);
+  if (sizes_.size() != errors_.size()) sizes_.clear();
+  current_ = 0;
+}
+
+std::size_t s21::LodSelector::levelCount() const { return errors_.size(); }
+
+void s21::LodSelector::setTolerance(float pixels) { tolerance_ = pixels; }
+
+void s21::LodSelector::setTargetFrameTime(double milliseconds) {
+  targetFrameTime_ = milliseconds;
+}
+
+void s21::LodSelector::reportFrameTime(double milliseconds) {
+  if (milliseconds > targetFrameTime_) {
+    scale_ = std::min(scale_ * kScaleStep, kMaxToleranceScale);
+  } else if (milliseconds < targetFrameTime_ * kFastFrame) {
+    scale_ = std::max(scale_ / kScaleStep, 1.0f);
+  }
+}
+
+float s21::LodSelector::getToleranceScale() const { return scale_; }
+
+void s21::LodSelector::setInteractive(bool interactive, std::size_t budget) {
+  interactive_ = interactive;
+  budget_ = budget;
+}
+
+std::size_t s21::LodSelector::select(float pixelsPerUnit) {
+  float tolerance = tolerance_ * scale_;
+  auto coarsest = [&](float limit) {
+    for (std::size_t level = errors_.size() - 1; level > 0; level--) {
+      if (errors_[level] * pixelsPerUnit <= limit) return level;
+    }
+    return std::size_t{0};
+  };
+  std::size_t coarser = coarsest(tolerance / kHysteresis);
+  if (coarser > current_) {
+    current_ = coarser;
+  } else if (errors_[current_] * pixelsPerUnit > tolerance * kHysteresis) {
+    current_ = coarsest(tolerance);
+  }
+  if (!interactive_ || sizes_.empty()) return current_;
+  // Уровень взаимодействия не запоминается, чтобы после него выбор по
+  // экранному размеру продолжился с прежнего уровня.
+  std::size_t affordable = errors_.size() - 1;
+  for (std::size_t level = 0; level < sizes_.size(); level++) {
+    if (sizes_[level] <= budget_) {
+      affordable = level;
+      break;
+    }
+  }
+  return std::max(current_, affordable);
+}
+
+std::size_t s21::LodSelector::getCurrent() const { return current_; }
+
+float s21::LodSelector::projectedRadius(const float *mvp,
+                                        const float center[3], float radius,
+                                        int viewportHeight) {
+  float middle[4];
+  project(mvp, center, middle);
+  if (middle[3] <= 0.0f) return HUGE_VALF;
+  float farthest = 0.0f;
+  for (int axis = 0; axis < 3; axis++) {
+    float point[3] = {center[0], center[1], center[2]};
+    point[axis] += radius;
+    float clip[4];
+    project(mvp, point, clip);
+    if (clip[3] <= 0.0f) return HUGE_VALF;
+    float dx = clip[0] / clip[3] - middle[0] / middle[3];
+    float dy = clip[1] / clip[3] - middle[1] / middle[3];
+    farthest = std::max(farthest, std::sqrt(dx * dx + dy * dy));
+  }
+  // Координаты NDC от -1 до 1 занимают всю высоту области вывода.
+  return farthest * static_cast<float>(viewportHeight) / 2.0f;
+}
+
+std::vector<int> s21::LodSelector::strideLines(const std::vector<int> &lines,
+                                               std::size_t budget) {
+  std::size_t pairs = lines.size() / 2;
+  std::size_t allowed = std::max<std::size_t>(budget / 2, 1);
+  std::size_t stride = (pairs + allowed - 1) / allowed;
+  if (stride <= 1) return lines;
+  std::vector<int> sampled{};
+  sampled.reserve((pairs + stride - 1) / stride * 2);
+  for (std::size_t pair = 0; pair < pairs; pair += stride)
+    sampled.insert(sampled.end(), {lines[pair * 2], lines[pair * 2 + 1]});
+  return sampled;
+}
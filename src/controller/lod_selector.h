@@ -0,0 +1,144 @@
+#ifndef LOD_SELECTOR_H_
+#define LOD_SELECTOR_H_
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+/**
+ * @class LodSelector
+ * @brief Выбирает уровень детализации по экранному размеру модели.
+ *
+ * Ошибка каждого уровня (в единицах модели) переводится в пиксели по
+ * масштабу проекции, и выбирается самый грубый уровень, ошибка которого
+ * не превышает допуска. Допуск растёт, пока кадры не укладываются в
+ * целевое время, и возвращается к исходному, когда запас появляется.
+ *
+ * Чтобы уровни не переключались туда-обратно на границе, переход на более
+ * грубый уровень требует ошибки меньше допуска в kHysteresis раз, а
+ * возврат к подробному происходит, только когда ошибка текущего уровня
+ * превысит допуск в kHysteresis раз.
+ *
+ * Пока пользователь двигает модель, выбирается уровень не подробнее
+ * того, что укладывается в бюджет индексов; после взаимодействия снова
+ * действует выбор по экранному размеру.
+ */
+class LodSelector {
+ public:
+  /// Ширина полосы гистерезиса.
+  static constexpr float kHysteresis = 1.25f;
+  /// Допуск экранной ошибки по умолчанию, в пикселях.
+  static constexpr float kDefaultTolerance = 1.0f;
+  /// Наибольший множитель допуска при медленных кадрах.
+  static constexpr float kMaxToleranceScale = 8.0f;
+
+  LodSelector();
+
+  /**
+   * @brief Задаёт уровни и возвращается к полной детализации.
+   * @param errors Ошибки уровней от подробного к грубому; уровень 0 -
+   * исходная модель с нулевой ошибкой.
+   * @param sizes Количество индексов рёбер уровней в том же порядке;
+   * пусто - бюджет взаимодействия не учитывается.
+   */
+  void setLevels(std::vector<float> errors,
+                 std::vector<std::size_t> sizes = {});
+
+  /**
+   * @brief Возвращает количество уровней вместе с исходной моделью.
+   * @return Количество уровней (std::size_t).
+   */
+  [[nodiscard]] std::size_t levelCount() const;
+
+  /**
+   * @brief Задаёт допуск экранной ошибки.
+   * @param pixels Допуск в пикселях.
+   */
+  void setTolerance(float pixels);
+
+  /**
+   * @brief Задаёт целевое время кадра; по умолчанию 1/30 секунды, так что
+   * кадры, ограниченные вертикальной синхронизацией 60 Гц, считаются
+   * быстрыми.
+   * @param milliseconds Время кадра в миллисекундах.
+   */
+  void setTargetFrameTime(double milliseconds);
+
+  /**
+   * @brief Учитывает время очередного кадра.
+   *
+   * Кадр дольше целевого увеличивает множитель допуска, кадр заметно
+   * короче - уменьшает до единицы.
+   *
+   * @param milliseconds Время кадра в миллисекундах.
+   */
+  void reportFrameTime(double milliseconds);
+
+  /**
+   * @brief Возвращает текущий множитель допуска.
+   * @return Множитель от 1 до kMaxToleranceScale (float).
+   */
+  [[nodiscard]] float getToleranceScale() const;
+
+  /**
+   * @brief Включает или выключает режим взаимодействия.
+   * @param interactive true, пока модель двигают.
+   * @param budget Наибольшее количество индексов рёбер уровня в режиме
+   * взаимодействия.
+   */
+  void setInteractive(bool interactive, std::size_t budget);
+
+  /**
+   * @brief Выбирает уровень для кадра.
+   * @param pixelsPerUnit Сколько пикселей занимает единица длины модели.
+   * @return Номер уровня; 0 - исходная модель (std::size_t).
+   */
+  std::size_t select(float pixelsPerUnit);
+
+  /**
+   * @brief Возвращает уровень, выбранный последним.
+   * @return Номер уровня (std::size_t).
+   */
+  [[nodiscard]] std::size_t getCurrent() const;
+
+  /**
+   * @brief Находит экранный радиус ограничивающей сферы.
+   *
+   * Центр и концы радиуса вдоль трёх осей модели проецируются матрицей
+   * MVP, и берётся наибольшее расстояние до проекции центра. Если центр
+   * оказался за камерой, радиус считается бесконечным.
+   *
+   * @param mvp Матрица MVP по строкам (вектор-столбец справа).
+   * @param center Центр сферы в координатах модели.
+   * @param radius Радиус сферы.
+   * @param viewportHeight Высота области вывода в пикселях.
+   * @return Радиус в пикселях (float).
+   */
+  static float projectedRadius(const float *mvp, const float center[3],
+                               float radius, int viewportHeight);
+
+  /**
+   * @brief Прореживает рёбра, оставляя каждое k-е, чтобы уложиться в
+   * бюджет.
+   *
+   * Годится как дешёвая замена каркаса, пока уровни детализации ещё не
+   * построены.
+   *
+   * @param lines Пары индексов рёбер.
+   * @param budget Наибольшее количество индексов результата.
+   * @return Пары индексов прореженных рёбер (std::vector<int>).
+   */
+  static std::vector<int> strideLines(const std::vector<int> &lines,
+                                      std::size_t budget);
+
+ private:
+  std::vector<float> errors_;  ///< Ошибки уровней, начиная с исходного.
+  std::vector<std::size_t> sizes_;  ///< Индексы рёбер уровней.
+  bool interactive_;                ///< Режим взаимодействия.
+  std::size_t budget_;  ///< Бюджет индексов в режиме взаимодействия.
+  std::size_t current_;        ///< Текущий уровень.
+  float tolerance_;            ///< Допуск экранной ошибки в пикселях.
+  float scale_;                ///< Множитель допуска по времени кадров.
+  double targetFrameTime_;     ///< Целевое время кадра в миллисекундах.
+};
+}  // namespace s21
+#endif  // LOD_SELECTOR_H_
@@ -0,0 +1,45 @@
+#include "model_loader.h"
+
+s21::ModelLoader::ModelLoader(std::string filename, ParseOptions options)
+    : filename_(std::move(filename)),
+      progress_(),
+      stream_(),
+      result_(),
+      error_(),
+      finished_(false) {
+  options.progress = &progress_;
+  options.stream = &stream_;
+  worker_ = std::thread(&ModelLoader::run, this, options);
+}
+
+s21::ModelLoader::~ModelLoader() {
+  progress_.cancel();
+  if (worker_.joinable()) worker_.join();
+}
+
+const std::string &s21::ModelLoader::getFilename() const { return filename_; }
+
+double s21::ModelLoader::getProgress() const { return progress_.fraction(); }
+
+s21::MeshStream &s21::ModelLoader::getStream() { return stream_; }
+
+bool s21::ModelLoader::isFinished() const {
+  return finished_.load(std::memory_order_acquire);
+}
+
+void s21::ModelLoader::cancel() { progress_.cancel(); }
+
+std::shared_ptr<s21::Controller> s21::ModelLoader::takeResult() {
+  if (worker_.joinable()) worker_.join();
+  if (error_) std::rethrow_exception(error_);
+  return std::move(result_);
+}
+
+void s21::ModelLoader::run(ParseOptions options) {
+  try {
+    result_ = std::make_shared<s21::Controller>(filename_, options);
+  } catch (...) {
+    error_ = std::current_exception();
+  }
+  finished_.store(true, std::memory_order_release);
+}
@@ -0,0 +1,101 @@
+#ifndef MODEL_LOADER_H_
+#define MODEL_LOADER_H_
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "../model/load_progress.h"
+#include "../model/mesh_stream.h"
+#include "obj_controller.h"
+
+namespace s21 {
+/**
+ * @class ModelLoader
+ * @brief Загружает модель в фоновом потоке.
+ *
+ * Интерфейс опрашивает прогресс и готовность загрузки, не блокируясь на
+ * разборе файла, и может отменить загрузку. Готовая модель забирается
+ * через takeResult() в потоке интерфейса.
+ */
+class ModelLoader {
+ public:
+  /**
+   * @brief Запускает загрузку модели.
+   * @param filename Имя файла модели.
+   * @param options Параметры загрузки; поля progress и stream заполняются
+   * загрузчиком.
+   */
+  ModelLoader(std::string filename, ParseOptions options = ParseOptions());
+
+  /**
+   * @brief Отменяет незавершённую загрузку и дожидается фонового потока.
+   */
+  ~ModelLoader();
+
+  ModelLoader(const ModelLoader &) = delete;
+  ModelLoader &operator=(const ModelLoader &) = delete;
+
+  /**
+   * @brief Возвращает имя загружаемого файла.
+   * @return Имя файла (const std::string&).
+   */
+  [[nodiscard]] const std::string &getFilename() const;
+
+  /**
+   * @brief Возвращает долю прочитанных байт файла.
+   * @return Значение от 0 до 1 (double).
+   */
+  [[nodiscard]] double getProgress() const;
+
+  /**
+   * @brief Возвращает очередь порций, публикуемых по ходу разбора.
+   *
+   * Порции позволяют показывать модель, не дожидаясь конца загрузки.
+   * Модель, загруженная из кэша, порций не публикует.
+   *
+   * @return Очередь порций (MeshStream&).
+   */
+  MeshStream &getStream();
+
+  /**
+   * @brief Проверяет, завершилась ли загрузка (успешно, с ошибкой или
+   * отменой).
+   * @return true, если можно вызывать takeResult().
+   */
+  [[nodiscard]] bool isFinished() const;
+
+  /**
+   * @brief Запрашивает отмену загрузки.
+   */
+  void cancel();
+
+  /**
+   * @brief Забирает загруженную модель.
+   *
+   * Дожидается завершения фонового потока. Если загрузка завершилась
+   * ошибкой или была отменена, пробрасывает соответствующее исключение
+   * (std::invalid_argument, LoadCancelled).
+   *
+   * @return Контроллер загруженной модели (std::shared_ptr<Controller>).
+   */
+  std::shared_ptr<Controller> takeResult();
+
+ private:
+  /**
+   * @brief Тело фонового потока.
+   * @param options Параметры загрузки.
+   */
+  void run(ParseOptions options);
+
+  std::string filename_;                ///< Имя файла модели.
+  LoadProgress progress_;               ///< Прогресс и отмена загрузки.
+  MeshStream stream_;                   ///< Порции разобранной модели.
+  std::shared_ptr<Controller> result_;  ///< Загруженная модель.
+  std::exception_ptr error_;            ///< Ошибка загрузки.
+  std::atomic<bool> finished_;          ///< Признак завершения потока.
+  std::thread worker_;                  ///< Фоновый поток.
+};
+}  // namespace s21
+#endif  // MODEL_LOADER_H_
@@ -1,9 +1,16 @@
 #include "obj_controller.h"
 
-s21::Controller::Controller(std::string filename) {
+s21::Controller::Controller(std::string filename, ParseOptions options) {
   // std::shared_ptr<s21::Model> modelNewInstance =
   // std::make_shared<s21::Model>(filename);
-  this->model = s21::Model(filename);
+  this->model = s21::Model(filename, options);
+}
+
+s21::Controller s21::Controller::fromText(std::string_view text,
+                                          ParseOptions options) {
+  Controller controller{};
+  controller.model = s21::Model::fromText(text, options);
+  return controller;
 }
 
 // s21::Model *s21::Controller::getModel()
@@ -15,6 +22,10 @@ const std::vector<float> &s21::Controller::getVertexes() {
   return model.getVertexes();
 }
 const std::vector<int> &s21::Controller::getEdges() { return model.getEdges(); }
+const std::vector<int> &s21::Controller::getLines() { return model.getLines(); }
+const std::vector<int> &s21::Controller::getOutlines() {
+  return model.getOutlines();
+}
 unsigned int s21::Controller::getVertexCount() const {
   return model.getVertexCount();
 }
@@ -26,4 +37,12 @@ float s21::Controller::getMaxX() const { return model.getMaxX(); }
 float s21::Controller::getMinY() const { return model.getMinY(); }
 float s21::Controller::getMaxY() const { return model.getMaxY(); }
 float s21::Controller::getMinZ() const { return model.getMinZ(); }
-float s21::Controller::getMaxZ() const { return model.getMaxZ(); }
\ No newline at end of file
+float s21::Controller::getMaxZ() const { return model.getMaxZ(); }
+float s21::Controller::getCenterX() const { return model.getCenterX(); }
+float s21::Controller::getCenterY() const { return model.getCenterY(); }
+float s21::Controller::getCenterZ() const { return model.getCenterZ(); }
+float s21::Controller::getRadius() const { return model.getRadius(); }
+
+const s21::WeldStats &s21::Controller::getWeldStats() const {
+  return model.getWeldStats();
+}
@@ -18,8 +18,18 @@ class Controller {
   /**
    * @brief Конструктор, принимающий имя файла модели для загрузки.
    * @param filename Имя файла, содержащего модель.
+   * @param options Параметры загрузки (число потоков разбора и т.д.).
    */
-  Controller(std::string filename);
+  Controller(std::string filename, ParseOptions options = ParseOptions());
+
+  /**
+   * @brief Создаёт контроллер для модели, разобранной из текста OBJ.
+   * @param text Текст OBJ, находящийся в памяти.
+   * @param options Параметры загрузки.
+   * @return Контроллер с разобранной моделью.
+   */
+  static Controller fromText(std::string_view text,
+                             ParseOptions options = ParseOptions());
 
   /**
    * @brief Получает ссылку на вектор вершин модели.
@@ -28,11 +38,23 @@ class Controller {
   [[nodiscard]] const std::vector<float> &getVertexes();
 
   /**
-   * @brief Получает ссылку на вектор рёбер модели.
-   * @return Константная ссылка на вектор рёбер (std::vector<int>).
+   * @brief Получает треугольники модели, по три индекса на треугольник.
+   * @return Константная ссылка на индексы треугольников (std::vector<int>).
    */
   [[nodiscard]] const std::vector<int> &getEdges();
 
+  /**
+   * @brief Получает уникальные рёбра модели для отрисовки отрезками.
+   * @return Константная ссылка на пары индексов (std::vector<int>).
+   */
+  [[nodiscard]] const std::vector<int> &getLines();
+
+  /**
+   * @brief Получает контуры граней модели, разделённые kPrimitiveRestart.
+   * @return Константная ссылка на контуры (std::vector<int>).
+   */
+  [[nodiscard]] const std::vector<int> &getOutlines();
+
   /**
    * @brief Получает количество вершин модели.
    * @return Количество вершин (unsigned int).
@@ -81,6 +103,36 @@ class Controller {
    */
   [[nodiscard]] float getMaxZ() const;
 
+  /**
+   * @brief Получает центр ограничивающего параллелепипеда модели по X.
+   * @return Координата X центра (float).
+   */
+  [[nodiscard]] float getCenterX() const;
+
+  /**
+   * @brief Получает центр ограничивающего параллелепипеда модели по Y.
+   * @return Координата Y центра (float).
+   */
+  [[nodiscard]] float getCenterY() const;
+
+  /**
+   * @brief Получает центр ограничивающего параллелепипеда модели по Z.
+   * @return Координата Z центра (float).
+   */
+  [[nodiscard]] float getCenterZ() const;
+
+  /**
+   * @brief Получает радиус сферы вокруг центра, содержащей модель.
+   * @return Радиус (float).
+   */
+  [[nodiscard]] float getRadius() const;
+
+  /**
+   * @brief Получает итоги сварки вершин при загрузке модели.
+   * @return Количество вершин до и после сварки и освобождённая память.
+   */
+  [[nodiscard]] const WeldStats &getWeldStats() const;
+
  private:
   /**
    * @brief Модель, управляемая данным контроллером.
@@ -0,0 +1,158 @@
+#include "bounding_box.h"
+
+#include <algorithm>
+
+#include "thread_pool.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define S21_BOUNDS_X86 1
+#endif
+
+namespace s21 {
+namespace {
+/// Количество вершин, обрабатываемых одной задачей.
+constexpr std::size_t kBlockVertexes = std::size_t{1} << 16;
+
+void addScalar(const float *vertexes, std::size_t count, BoundingBox &box) {
+  for (std::size_t i = 0; i < count; i++) {
+    for (int axis = 0; axis < 3; axis++) {
+      box.min[axis] = std::min(box.min[axis], vertexes[i * 3 + axis]);
+      box.max[axis] = std::max(box.max[axis], vertexes[i * 3 + axis]);
+    }
+  }
+}
+
+/**
+ * @brief Сводит векторные аккумуляторы к границам по осям.
+ *
+ * Вершины идут подряд по три координаты, поэтому в r-м из трёх регистров
+ * по lanes дорожек дорожка l содержит ось (r * lanes + l) % 3.
+ */
+void foldLanes(const float *mins, const float *maxs, int lanes,
+               BoundingBox &box) {
+  for (int i = 0; i < lanes * 3; i++) {
+    int axis = i % 3;
+    box.min[axis] = std::min(box.min[axis], mins[i]);
+    box.max[axis] = std::max(box.max[axis], maxs[i]);
+  }
+}
+
+#ifdef S21_BOUNDS_X86
+std::size_t addSse2(const float *vertexes, std::size_t count,
+                    BoundingBox &box) {
+  __m128 min[3], max[3];
+  for (int r = 0; r < 3; r++) {
+    min[r] = _mm_set1_ps(HUGE_VALF);
+    max[r] = _mm_set1_ps(-HUGE_VALF);
+  }
+  std::size_t done = count / 4 * 4;
+  for (std::size_t i = 0; i < done; i += 4) {
+    for (int r = 0; r < 3; r++) {
+      __m128 value = _mm_loadu_ps(vertexes + i * 3 + r * 4);
+      min[r] = _mm_min_ps(min[r], value);
+      max[r] = _mm_max_ps(max[r], value);
+    }
+  }
+  float mins[12], maxs[12];
+  for (int r = 0; r < 3; r++) {
+    _mm_storeu_ps(mins + r * 4, min[r]);
+    _mm_storeu_ps(maxs + r * 4, max[r]);
+  }
+  foldLanes(mins, maxs, 4, box);
+  return done;
+}
+
+__attribute__((target("avx2"))) std::size_t addAvx2(const float *vertexes,
+                                                      std::size_t count,
+                                                      BoundingBox &box) {
+  __m256 min[3], max[3];
+  for (int r = 0; r < 3; r++) {
+    min[r] = _mm256_set1_ps(HUGE_VALF);
+    max[r] = _mm256_set1_ps(-HUGE_VALF);
+  }
+  std::size_t done = count / 8 * 8;
+  for (std::size_t i = 0; i < done; i += 8) {
+    for (int r = 0; r < 3; r++) {
+      __m256 value = _mm256_loadu_ps(vertexes + i * 3 + r * 8);
+      min[r] = _mm256_min_ps(min[r], value);
+      max[r] = _mm256_max_ps(max[r], value);
+    }
+  }
+  float mins[24], maxs[24];
+  for (int r = 0; r < 3; r++) {
+    _mm256_storeu_ps(mins + r * 8, min[r]);
+    _mm256_storeu_ps(maxs + r * 8, max[r]);
+  }
+  foldLanes(mins, maxs, 8, box);
+  return done;
+}
+
+bool hasAvx2() {
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+}
+#endif
+}  // namespace
+
+bool BoundingBox::empty() const { return min[0] > max[0]; }
+
+void BoundingBox::merge(const BoundingBox &other) {
+  for (int axis = 0; axis < 3; axis++) {
+    min[axis] = std::min(min[axis], other.min[axis]);
+    max[axis] = std::max(max[axis], other.max[axis]);
+  }
+}
+
+void BoundingBox::center(float center[3]) const {
+  for (int axis = 0; axis < 3; axis++)
+    center[axis] = empty() ? 0.0f : (min[axis] + max[axis]) / 2.0f;
+}
+
+BoundingBox BoundingBox::compute(const float *vertexes, std::size_t count) {
+  BoundingBox box{};
+  std::size_t done = 0;
+#ifdef S21_BOUNDS_X86
+  done = hasAvx2() ? addAvx2(vertexes, count, box)
+                   : addSse2(vertexes, count, box);
+#endif
+  addScalar(vertexes + done * 3, count - done, box);
+  return box;
+}
+
+BoundingBox BoundingBox::compute(const std::vector<float> &vertexes,
+                                 ThreadPool &pool) {
+  std::size_t count = vertexes.size() / 3;
+  std::size_t blocks = (count + kBlockVertexes - 1) / kBlockVertexes;
+  std::vector<BoundingBox> boxes(blocks);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t first = block * kBlockVertexes;
+    boxes[block] = compute(vertexes.data() + first * 3,
+                           std::min(kBlockVertexes, count - first));
+  });
+  BoundingBox box{};
+  for (const BoundingBox &part : boxes) box.merge(part);
+  return box;
+}
+
+float BoundingBox::radius(const std::vector<float> &vertexes,
+                          const float center[3], ThreadPool &pool) {
+  std::size_t count = vertexes.size() / 3;
+  std::size_t blocks = (count + kBlockVertexes - 1) / kBlockVertexes;
+  std::vector<float> distances(blocks);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockVertexes, count);
+    float farthest = 0.0f;
+    for (std::size_t i = block * kBlockVertexes; i < end; i++) {
+      float dx = vertexes[i * 3] - center[0];
+      float dy = vertexes[i * 3 + 1] - center[1];
+      float dz = vertexes[i * 3 + 2] - center[2];
+      farthest = std::max(farthest, dx * dx + dy * dy + dz * dz);
+    }
+    distances[block] = farthest;
+  });
+  float farthest = 0.0f;
+  for (float distance : distances) farthest = std::max(farthest, distance);
+  return std::sqrt(farthest);
+}
+}  // namespace s21
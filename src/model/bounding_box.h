@@ -0,0 +1,79 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_BOUNDING_BOX_H_
+#define VIEWER_FRONT_SRC_MODEL_BOUNDING_BOX_H_
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+class ThreadPool;
+
+/**
+ * @brief Ограничивающий параллелепипед, выровненный по осям.
+ *
+ * Пустой параллелепипед имеет min = +inf и max = -inf, поэтому первое же
+ * объединение с вершиной или другим параллелепипедом даёт верные границы
+ * независимо от знака координат.
+ */
+struct BoundingBox {
+  float min[3]{HUGE_VALF, HUGE_VALF, HUGE_VALF};     ///< Минимумы по осям.
+  float max[3]{-HUGE_VALF, -HUGE_VALF, -HUGE_VALF};  ///< Максимумы по осям.
+
+  /**
+   * @brief Проверяет, что в параллелепипед не добавлено ни одной точки.
+   *
+   * @return bool true для пустого параллелепипеда.
+   */
+  [[nodiscard]] bool empty() const;
+
+  /**
+   * @brief Расширяет параллелепипед до другого параллелепипеда.
+   *
+   * @param other Добавляемый параллелепипед.
+   */
+  void merge(const BoundingBox &other);
+
+  /**
+   * @brief Находит центр параллелепипеда.
+   *
+   * @param center Координаты центра; нули для пустого параллелепипеда.
+   */
+  void center(float center[3]) const;
+
+  /**
+   * @brief Находит границы вершин.
+   *
+   * Минимумы и максимумы копятся векторными регистрами сразу по всем
+   * трём осям (AVX2 или SSE2 в зависимости от процессора), без разбора
+   * координат по осям.
+   *
+   * @param vertexes Координаты вершин, по три на вершину.
+   * @param count Количество вершин.
+   * @return BoundingBox Границы вершин.
+   */
+  static BoundingBox compute(const float *vertexes, std::size_t count);
+
+  /**
+   * @brief Находит границы вершин параллельно.
+   *
+   * @param vertexes Координаты вершин, по три на вершину.
+   * @param pool Пул потоков.
+   * @return BoundingBox Границы вершин.
+   */
+  static BoundingBox compute(const std::vector<float> &vertexes,
+                             ThreadPool &pool);
+
+  /**
+   * @brief Находит радиус сферы с заданным центром, содержащей вершины.
+   *
+   * @param vertexes Координаты вершин, по три на вершину.
+   * @param center Центр сферы.
+   * @param pool Пул потоков.
+   * @return float Наибольшее расстояние от центра до вершины.
+   */
+  static float radius(const std::vector<float> &vertexes,
+                      const float center[3], ThreadPool &pool);
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_BOUNDING_BOX_H_
@@ -4,44 +4,62 @@
 
 #include "camera_model.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "thread_pool.h"
+
 namespace s21 {
+namespace {
+/// Количество точек, преобразуемых одной задачей.
+constexpr std::size_t kBlockPoints = std::size_t{1} << 16;
+
+/// Матрица вида, вычисленная при компиляции.
+constexpr Mat4f kViewMatrix = Camera::viewMatrix();
+}  // namespace
+
+Quat operator*(const Quat &a, const Quat &b) {
+  return Quat{a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+              a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+              a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+              a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+}
 
 void Camera::calculateModelMatrix(Controller *shape) {
-  float translationMatrix[16] = {1,   0.0, 0.0, 0.0, 0.0, 1,   0.0, 0.0,
-                                 0.0, 0.0, 1,   -1,  0.0, 0.0, 0.0, 1};
-
-  float maxExtent = shape->getMaxX() > shape->getMaxY()
-                        ? shape->getMaxX() > shape->getMaxZ() ? shape->getMaxX()
-                                                              : shape->getMaxZ()
-                    : shape->getMaxY() > shape->getMaxZ() ? shape->getMaxY()
-                                                          : shape->getMaxZ();
-  float scaleFactor = 0.6 / maxExtent;
-
-  float scalingMatrix[16] = {
-      scaleFactor, 0.0f, 0.0f,        0.0f, 0.0f, scaleFactor, 0.0f, 0.0f,
-      0.0f,        0.0f, scaleFactor, 0.0f, 0.0f, 0.0f,        0.0f, 1.0f};
-  multiply(scalingMatrix, translationMatrix, modelMatrix_);
-}
-void Camera::multiply(float *a, float *b, float *result) {
-  for (int row = 0; row < 4; ++row) {
-    for (int col = 0; col < 4; ++col) {
-      float sum = 0.0;
-      for (int i = 0; i < 4; ++i) {
-        sum += a[row * 4 + i] * b[i * 4 + col];
-      }
-      result[row * 4 + col] = sum;
-    }
-  }
+  calculateModelMatrix(
+      Vec3f{shape->getMinX(), shape->getMinY(), shape->getMinZ()},
+      Vec3f{shape->getMaxX(), shape->getMaxY(), shape->getMaxZ()});
+}
+void Camera::calculateModelMatrix(const Vec3f &min, const Vec3f &max) {
+  Vec3f extent = max - min;
+  float maxExtent = std::max({extent.x, extent.y, extent.z});
+  fitCenter_ = (min + max) * 0.5f;
+  // Пустые границы (min = +inf, max = -inf) и одна точка не задают
+  // масштаба.
+  if (!(maxExtent > 0.0f) || !std::isfinite(maxExtent)) maxExtent = 2.0f;
+  if (!std::isfinite(dot(fitCenter_, fitCenter_))) fitCenter_ = Vec3f{};
+  float scaleFactor = 1.2f / maxExtent;
+
+  modelMatrix_ =
+      scaling(scaleFactor) * translation(fitCenter_ * -1.0f - Vec3f{0, 0, 1});
+  dirty_ |= kModelDirty;
+}
+void Camera::multiply(const float *a, const float *b, float *result) {
+  multiplyMatrices(a, b, result);
 }
 void Camera::setModelPosition(float x, float y, float z) {
-  modelMatrix_[3] = x;
-  modelMatrix_[7] = y;
-  modelMatrix_[11] = z;
+  modelMatrix_[3] = x - modelMatrix_[0] * fitCenter_.x;
+  modelMatrix_[7] = y - modelMatrix_[5] * fitCenter_.y;
+  modelMatrix_[11] = z - modelMatrix_[10] * fitCenter_.z;
+  dirty_ |= kModelDirty;
+}
+Vec3f Camera::getModelPosition() const {
+  return Vec3f{modelMatrix_[3] + modelMatrix_[0] * fitCenter_.x,
+               modelMatrix_[7] + modelMatrix_[5] * fitCenter_.y,
+               modelMatrix_[11] + modelMatrix_[10] * fitCenter_.z};
 }
 void Camera::setModelScale(float scale) {
-  modelMatrix_[0] = scale;
-  modelMatrix_[5] = scale;
-  modelMatrix_[10] = scale;
+  scaleModelAround(scale);
 }
 void Camera::calculateRotationMatrix(float xAngle, float yAngle, float zAngle) {
   float xRad = xAngle * (M_PI / 180.0);
@@ -54,17 +72,49 @@ void Camera::calculateRotationMatrix(float xAngle, float yAngle, float zAngle) {
   float cosY = cos(yRad);
   float cosZ = cos(zRad);
 
-  float rotateXmatrix[16] = {1, 0,    0,    0, 0, cosX, -sinX, 0,
-                             0, sinX, cosX, 0, 0, 0,    0,     1};
+  Mat4f rotateXmatrix = {{1, 0, 0, 0, 0, cosX, -sinX, 0, 0, sinX, cosX, 0, 0,
+                         0, 0, 1}};
+
+  Mat4f rotateYmatrix = {{cosY, 0, -sinY, 0, 0, 1, 0, 0, sinY, 0, cosY, 0, 0,
+                         0, 0, 1}};
+
+  Mat4f rotateZmatrix = {{cosZ, -sinZ, 0, 0, sinZ, cosZ, 0, 0, 0, 0, 1, 0, 0,
+                         0, 0, 1}};
+
+  rotationMatrix_ = rotateYmatrix * (rotateXmatrix * rotateZmatrix);
+  dirty_ |= kRotationDirty;
+}
+
+void Camera::setRotation(const Quat &rotation) {
+  float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+  rotationMatrix_ = Mat4f{{1 - 2 * (y * y + z * z), 2 * (x * y - w * z),
+                          2 * (x * z + w * y), 0, 2 * (x * y + w * z),
+                          1 - 2 * (x * x + z * z), 2 * (y * z - w * x), 0,
+                          2 * (x * z - w * y), 2 * (y * z + w * x),
+                          1 - 2 * (x * x + y * y), 0, 0, 0, 0, 1}};
+  dirty_ |= kRotationDirty;
+}
 
-  float rotateYmatrix[16] = {cosY, 0, -sinY, 0, 0, 1, 0, 0,
-                             sinY, 0, cosY,  0, 0, 0, 0, 1};
+void Camera::translateModel(float dx, float dy) {
+  modelMatrix_[3] += dx;
+  modelMatrix_[7] += dy;
+  dirty_ |= kModelDirty;
+}
 
-  float rotateZmatrix[16] = {cosZ, -sinZ, 0, 0, sinZ, cosZ, 0, 0,
-                             0,    0,     1, 0, 0,    0,    0, 1};
+void Camera::scaleModel(float factor) {
+  scaleModelAround(modelMatrix_[0] * factor);
+}
 
-  multiply(rotateXmatrix, rotateZmatrix, rotationMatrix_);
-  multiply(rotateYmatrix, rotationMatrix_, rotationMatrix_);
+void Camera::scaleModelAround(float scale) {
+  // Перенос равен position - scale * center; позиция центра модели
+  // при смене масштаба не меняется.
+  modelMatrix_[3] += (modelMatrix_[0] - scale) * fitCenter_.x;
+  modelMatrix_[7] += (modelMatrix_[5] - scale) * fitCenter_.y;
+  modelMatrix_[11] += (modelMatrix_[10] - scale) * fitCenter_.z;
+  modelMatrix_[0] = scale;
+  modelMatrix_[5] = scale;
+  modelMatrix_[10] = scale;
+  dirty_ |= kModelDirty;
 }
 
 void Camera::s21Frustum(float aspect, float fov, float near, float far) {
@@ -76,30 +126,15 @@ void Camera::s21Frustum(float aspect, float fov, float near, float far) {
   float right = top * aspect;
   float left = -right;
 
-  float A = (right + left) / (right - left);
-  float B = (top + bot) / (top - bot);
-  float C = -(far + near) / (far - near);
-  float D = -(2.0f * far * near) / (far - near);
-
-  projectionMatrix_[0] = (2.0f * near) / (right - left);
-  projectionMatrix_[1] = 0.0f;
-  projectionMatrix_[2] = 0.0f;
-  projectionMatrix_[3] = 0.0f;
-
-  projectionMatrix_[4] = 0.0f;
-  projectionMatrix_[5] = (2.0f * near) / (top - bot);
-  projectionMatrix_[6] = 0.0f;
-  projectionMatrix_[7] = 0.0f;
-
-  projectionMatrix_[8] = A;
-  projectionMatrix_[9] = B;
-  projectionMatrix_[10] = C;
-  projectionMatrix_[11] = -1.0f;
-
-  projectionMatrix_[12] = 0.0f;
-  projectionMatrix_[13] = 0.0f;
-  projectionMatrix_[14] = D;
-  projectionMatrix_[15] = 1.0f;
+  // MVP собирается как (model * rotation) * (view * projection), поэтому
+  // проекция хранится транспонированной. Единица в правом нижнем углу
+  // осталась от прежней реализации, и на неё настроен вид модели.
+  // Ненулевые элементы переставляются явно: общий transpose через
+  // временную матрицу заметно замедлял пересчёт MVP на каждом кадре.
+  Mat4f p = frustum(left, right, bot, top, near, far);
+  projectionMatrix_ = Mat4f{{p[0], 0, 0, 0, 0, p[5], 0, 0, p[2], p[6], p[10],
+                             p[14], 0, 0, p[11], 1}};
+  dirty_ |= kProjectionDirty;
 }
 
 void Camera::s21Ortho(float aspect, float fov, float near, float far) {
@@ -111,88 +146,93 @@ void Camera::s21Ortho(float aspect, float fov, float near, float far) {
   float right = top * aspect;
   float left = -right;
 
-  float tx = -(right + left) / (right - left);
-  float ty = -(top + bot) / (top - bot);
-  float tz = -(far + near) / (far - near);
-
-  projectionMatrix_[0] = 2.0f / (right - left);
-  projectionMatrix_[1] = 0.0f;
-  projectionMatrix_[2] = 0.0f;
-  projectionMatrix_[3] = 0.0f;
-
-  projectionMatrix_[4] = 0.0f;
-  projectionMatrix_[5] = 2.0f / (top - bot);
-  projectionMatrix_[6] = 0.0f;
-  projectionMatrix_[7] = 0.0f;
-
-  projectionMatrix_[8] = 0.0f;
-  projectionMatrix_[9] = 0.0f;
-  projectionMatrix_[10] = -2.0f / (far - near);
-  projectionMatrix_[11] = 0.0f;
-
-  projectionMatrix_[12] = tx;
-  projectionMatrix_[13] = ty;
-  projectionMatrix_[14] = tz;
-  projectionMatrix_[15] = 1.0f;
+  projectionMatrix_ = transpose(ortho(left, right, bot, top, near, far));
+  dirty_ |= kProjectionDirty;
 }
 
 void Camera::calculateViewMatrix() {
-  Vec4 cameraPos = {0.0f, 0.0f, -1.0f, 0.0f};
-  Vec4 cameraTarget = {0.0f, 0.0f, 0.0f, 0.0f};
-  Vec4 cameraDirection = normalize(subtract(cameraPos, cameraTarget));
-  Vec4 up = {0.0f, 1.0f, 0.0f, 0.0f};
-  Vec4 cameraRight = normalize(cross(up, cameraDirection));
-  Vec4 cameraUp = cross(cameraDirection, cameraRight);
-
-  float a[16] = {cameraRight.x,
-                 cameraRight.y,
-                 cameraRight.z,
-                 0,
-                 cameraUp.x,
-                 cameraUp.y,
-                 cameraUp.z,
-                 0,
-                 cameraDirection.x,
-                 cameraDirection.y,
-                 cameraDirection.z,
-                 0,
-                 0,
-                 0,
-                 0,
-                 1};
+  viewMatrix_ = kViewMatrix;
+  dirty_ |= kViewDirty;
+}
 
-  float b[16] = {1, 0, 0, -cameraPos.x, 0, 1, 0, -cameraPos.y,
-                 0, 0, 1, -cameraPos.z, 0, 0, 0, 1};
+Quat Camera::normalize(Quat q) {
+  float length = sqrtf(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+  if (!(length > 0.0f)) return Quat{1, 0, 0, 0};
+  float inverse = 1.0f / length;
+  return Quat{q.w * inverse, q.x * inverse, q.y * inverse, q.z * inverse};
+}
 
-  multiply(b, a, viewMatrix_);
+Quat Camera::eulerRotation(float xAngle, float yAngle, float zAngle) {
+  float xHalf = xAngle * (M_PI / 360.0);
+  float yHalf = yAngle * (M_PI / 360.0);
+  float zHalf = zAngle * (M_PI / 360.0);
+  // Матрица вращения вокруг Y в calculateRotationMatrix поворачивает
+  // на -yAngle, поэтому у этой оси знак обратный.
+  Quat rotateX{cosf(xHalf), sinf(xHalf), 0, 0};
+  Quat rotateY{cosf(yHalf), 0, -sinf(yHalf), 0};
+  Quat rotateZ{cosf(zHalf), 0, 0, sinf(zHalf)};
+  return rotateY * (rotateX * rotateZ);
 }
 
-Vec4 Camera::cross(Vec4 a, Vec4 b) {
-  return (Vec4){a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
-                a.x * b.y - a.y * b.x, 1};
+Vec4f Camera::arcballPoint(float x, float y) {
+  float d2 = x * x + y * y;
+  float z = d2 <= 0.5f ? sqrtf(1.0f - d2) : 0.5f / sqrtf(d2);
+  float inverse = 1.0f / sqrtf(d2 + z * z);
+  return Vec4f{x * inverse, y * inverse, z * inverse, 0};
 }
 
-Vec4 Camera::normalize(Vec4 v) {
-  float length = sqrt(v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w);
-  return (Vec4){v.x / length, v.y / length, v.z / length, 1.0};
+Quat Camera::arc(Vec4f from, Vec4f to) {
+  // Кватернион (1 + from·to, from×to) задаёт поворот на угол между
+  // векторами, а не на удвоенный, как (from·to, from×to).
+  float dot = from.x * to.x + from.y * to.y + from.z * to.z;
+  if (!(dot > -0.999999f)) return Quat{1, 0, 0, 0};
+  return normalize(Quat{1.0f + dot, from.y * to.z - from.z * to.y,
+                        from.z * to.x - from.x * to.z,
+                        from.x * to.y - from.y * to.x});
 }
 
-Vec4 Camera::subtract(Vec4 a, Vec4 b) {
-  return (Vec4){a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w};
+const float *Camera::updateMvp() {
+  if (dirty_ == 0) return mvpMatrix_.m;
+  if (dirty_ & (kModelDirty | kRotationDirty))
+    modelRotation_ = modelMatrix_ * rotationMatrix_;
+  if (dirty_ & (kViewDirty | kProjectionDirty))
+    viewProjection_ = viewMatrix_ * projectionMatrix_;
+  mvpMatrix_ = modelRotation_ * viewProjection_;
+  dirty_ = 0;
+  return mvpMatrix_.m;
+}
+void Camera::transformPoints(const float *in, float *out, std::size_t count,
+                             Space space, ThreadPool &pool) {
+  updateMvp();
+  const Mat4f &matrix = space == kModel ? modelRotation_ : mvpMatrix_;
+  bool project = space == kDevice;
+  if (count <= kBlockPoints) {
+    s21::transformPoints(matrix.m, in, out, count, project);
+    return;
+  }
+  std::size_t blocks = (count + kBlockPoints - 1) / kBlockPoints;
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t first = block * kBlockPoints;
+    s21::transformPoints(matrix.m, in + first * 3, out + first * 3,
+                         std::min(kBlockPoints, count - first), project);
+  });
 }
 void Camera::multModelRotation() {
-  Camera::multiply(modelMatrix_, rotationMatrix_, mvpMatrix_);
+  mvpMatrix_ = modelMatrix_ * rotationMatrix_;
+  dirty_ |= kMvpDirty;
 }
 void Camera::multMvpView() {
-  Camera::multiply(mvpMatrix_, viewMatrix_, mvpMatrix_);
+  mvpMatrix_ = mvpMatrix_ * viewMatrix_;
+  dirty_ |= kMvpDirty;
 }
 void Camera::multMvpProjection() {
-  Camera::multiply(mvpMatrix_, projectionMatrix_, mvpMatrix_);
+  mvpMatrix_ = mvpMatrix_ * projectionMatrix_;
+  dirty_ |= kMvpDirty;
 }
-float *Camera::getModelMatrix() { return modelMatrix_; }
-float *Camera::getViewMatrix() { return viewMatrix_; }
-float *Camera::getProjectionMatrix() { return projectionMatrix_; }
-float *Camera::getMvpMatrix() { return mvpMatrix_; }
-float *Camera::getRotataionMatrix() { return rotationMatrix_; }
+float *Camera::getModelMatrix() { return modelMatrix_.m; }
+float *Camera::getViewMatrix() { return viewMatrix_.m; }
+float *Camera::getProjectionMatrix() { return projectionMatrix_.m; }
+float *Camera::getMvpMatrix() { return mvpMatrix_.m; }
+float *Camera::getRotataionMatrix() { return rotationMatrix_.m; }
 
 }  // namespace s21
\ No newline at end of file
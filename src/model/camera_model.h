@@ -5,58 +5,50 @@
 #ifndef VIEWER_FRONT_SRC_BACKEND_CAMERA_H_
 #define VIEWER_FRONT_SRC_BACKEND_CAMERA_H_
 
+#include <cstddef>
+
 #include "../controller/obj_controller.h"
+#include "linear_algebra.h"
 #include "obj_model.h"
 
+namespace s21 {
+class ThreadPool;
+
 /**
- * @brief Структура для представления вектора в 4D пространстве.
+ * @brief Кватернион вращения w + xi + yj + zk.
  */
-struct Vec4 {
-  float x;  ///< Координата по оси X.
-  float y;  ///< Координата по оси Y.
-  float z;  ///< Координата по оси Z.
-  float w;  ///< Четвёртая координата (обычно используется для однородных
-            ///< координат).
+struct Quat {
+  float w;  ///< Скалярная часть.
+  float x;  ///< Коэффициент при i.
+  float y;  ///< Коэффициент при j.
+  float z;  ///< Коэффициент при k.
 };
 
 /**
- * @brief Структура для представления матрицы 4x4.
+ * @brief Составляет вращения: сначала b, затем a.
+ *
+ * @param a Второе вращение.
+ * @param b Первое вращение.
+ * @return Quat Произведение a * b.
  */
-struct Mat4 {
-  float m[16];  ///< Элементы матрицы.
-};
+Quat operator*(const Quat &a, const Quat &b);
 
-namespace s21 {
 /**
  * @brief Класс для представления камеры в 3D пространстве.
+ *
+ * MVP собирается как (model * rotation) * (view * projection). Каждый
+ * метод, меняющий одну из матриц, помечает её изменённой, а updateMvp
+ * пересчитывает только зависящие от неё произведения и кэширует
+ * результат до следующего изменения.
  */
 class Camera {
  public:
-  /**
-   * @brief Конструктор камеры.
-   *
-   * Инициализирует матрицы модели, вида, проекции, MVP и вращения.
-   */
-  Camera() {
-    modelMatrix_ = new float[16]{};
-    viewMatrix_ = new float[16]{};
-    projectionMatrix_ = new float[16]{};
-    mvpMatrix_ = new float[16]{};
-    rotationMatrix_ = new float[16]{};
-  }
+  /// Пространство, в которое transformPoints переводит точки.
+  enum Space {
+    kModel,  ///< После положения, масштаба и вращения модели.
+    kDevice  ///< Нормализованные координаты устройства, как в шейдере.
+  };
 
-  /**
-   * @brief Деструктор камеры.
-   *
-   * Освобождает память, занятую матрицами.
-   */
-  ~Camera() {
-    delete[] modelMatrix_;
-    delete[] viewMatrix_;
-    delete[] projectionMatrix_;
-    delete[] mvpMatrix_;
-    delete[] rotationMatrix_;
-  }
   /**
    * @brief Геттер матрицы модели.
    *
@@ -100,7 +92,24 @@ class Camera {
   void calculateModelMatrix(Controller *shape);
 
   /**
-   * @brief Устанавливает позицию модели.
+   * @brief Вписывает параллелепипед границ в область просмотра.
+   *
+   * Позволяет уточнять вписывание модели по мере загрузки, когда
+   * известны только границы уже разобранной части. Центр границ
+   * переносится в начало координат, а наибольшая сторона
+   * масштабируется до 1.2, поэтому модель в любой части пространства
+   * оказывается в центре экрана. Центр запоминается: setModelPosition,
+   * setModelScale и scaleModel задают положение и масштаб относительно
+   * него. Пустые или вырожденные границы вписываются как куб со
+   * стороной 2.
+   *
+   * @param min Наименьшие координаты модели.
+   * @param max Наибольшие координаты модели.
+   */
+  void calculateModelMatrix(const Vec3f &min, const Vec3f &max);
+
+  /**
+   * @brief Устанавливает позицию центра модели.
    *
    * @param x Позиция по оси X.
    * @param y Позиция по оси Y.
@@ -108,6 +117,16 @@ class Camera {
    */
   void setModelPosition(float x, float y, float z);
 
+  /**
+   * @brief Возвращает позицию центра модели.
+   *
+   * Позиция задаётся так же, как в setModelPosition, и учитывает сдвиг
+   * мышью, поэтому передача её в setModelPosition не меняет матрицу.
+   *
+   * @return Vec3f Позиция центра модели.
+   */
+  Vec3f getModelPosition() const;
+
   /**
    * @brief Устанавливает масштаб модели.
    *
@@ -124,6 +143,34 @@ class Camera {
    */
   void calculateRotationMatrix(float xAngle, float yAngle, float zAngle);
 
+  /**
+   * @brief Устанавливает матрицу вращения по кватерниону.
+   *
+   * Матрица заполняется напрямую из компонент кватерниона, без
+   * произведений матриц.
+   *
+   * @param rotation Единичный кватернион вращения.
+   */
+  void setRotation(const Quat &rotation);
+
+  /**
+   * @brief Сдвигает модель в плоскости экрана.
+   *
+   * Сдвиг прибавляется после всех преобразований, поэтому задаётся
+   * в нормализованных координатах экрана.
+   *
+   * @param dx Сдвиг по горизонтали.
+   * @param dy Сдвиг по вертикали.
+   */
+  void translateModel(float dx, float dy);
+
+  /**
+   * @brief Умножает текущий масштаб модели.
+   *
+   * @param factor Множитель масштаба.
+   */
+  void scaleModel(float factor);
+
   /**
    * @brief Устанавливает параметры перспективной проекции.
    *
@@ -149,6 +196,34 @@ class Camera {
    */
   void calculateViewMatrix();
 
+  /**
+   * @brief Пересчитывает изменившиеся звенья MVP.
+   *
+   * Ползунки положения, масштаба и вращения меняют только левую пару
+   * матриц, поэтому между кадрами обычно пересчитываются два
+   * произведения; без изменений не пересчитывается ничего.
+   *
+   * @return const float* MVP по строкам, вектор умножается справа.
+   */
+  const float *updateMvp();
+
+  /**
+   * @brief Применяет текущие матрицы к массиву точек.
+   *
+   * Для kModel точки умножаются на model * rotation, для kDevice - на
+   * MVP с делением на w. Точки делятся на блоки, которые пул
+   * преобразует параллельно; небольшие массивы преобразуются в
+   * вызывающем потоке.
+   *
+   * @param in Координаты точек, по три на точку.
+   * @param out Преобразованные координаты; может совпадать с in.
+   * @param count Количество точек.
+   * @param space Пространство результата.
+   * @param pool Пул потоков.
+   */
+  void transformPoints(const float *in, float *out, std::size_t count,
+                       Space space, ThreadPool &pool);
+
   /**
    * @brief Умножает матрицу вращения модели.
    */
@@ -169,42 +244,138 @@ class Camera {
    *
    * @param a Первый вектор.
    * @param b Второй вектор.
-   * @return Vec4 Результат векторного произведения.
+   * @return Vec4f Результат векторного произведения.
    */
-  static Vec4 cross(Vec4 a, Vec4 b);
+  static constexpr Vec4f cross(Vec4f a, Vec4f b) {
+    Vec3f product = s21::cross(Vec3f{a.x, a.y, a.z}, Vec3f{b.x, b.y, b.z});
+    return Vec4f{product.x, product.y, product.z, 1};
+  }
 
   /**
    * @brief Нормализует вектор.
    *
+   * Длина считается по всем четырём координатам, а w результата
+   * равна 1.
+   *
    * @param v Вектор для нормализации.
-   * @return Vec4 Нормализованный вектор.
+   * @return Vec4f Нормализованный вектор.
    */
-  static Vec4 normalize(Vec4 v);
+  static constexpr Vec4f normalize(Vec4f v) {
+    float length = squareRoot(dot(v, v));
+    return Vec4f{v.x / length, v.y / length, v.z / length, 1};
+  }
 
   /**
    * @brief Вычитает векторы.
    *
    * @param a Первый вектор.
    * @param b Второй вектор.
-   * @return Vec4 Результат вычитания.
+   * @return Vec4f Результат вычитания.
    */
-  static Vec4 subtract(Vec4 a, Vec4 b);
+  static constexpr Vec4f subtract(Vec4f a, Vec4f b) { return a - b; }
+
+  /**
+   * @brief Строит матрицу вида камеры, смотрящей из (0, 0, -1) в начало
+   * координат.
+   *
+   * Камера неподвижна, поэтому матрица вычисляется при компиляции,
+   * а calculateViewMatrix только копирует её.
+   *
+   * @return Mat4f Матрица вида.
+   */
+  static constexpr Mat4f viewMatrix() {
+    Vec4f cameraPos = {0.0f, 0.0f, -1.0f, 0.0f};
+    Vec4f cameraTarget = {0.0f, 0.0f, 0.0f, 0.0f};
+    Vec4f cameraDirection = normalize(subtract(cameraPos, cameraTarget));
+    Vec4f up = {0.0f, 1.0f, 0.0f, 0.0f};
+    Vec4f cameraRight = normalize(cross(up, cameraDirection));
+    Vec4f cameraUp = cross(cameraDirection, cameraRight);
+
+    Mat4f a = {{cameraRight.x, cameraRight.y, cameraRight.z, 0, cameraUp.x,
+                cameraUp.y, cameraUp.z, 0, cameraDirection.x,
+                cameraDirection.y, cameraDirection.z, 0, 0, 0, 0, 1}};
+    return translation(Vec3f{-cameraPos.x, -cameraPos.y, -cameraPos.z}) * a;
+  }
+
+  /**
+   * @brief Нормализует кватернион.
+   *
+   * @param q Кватернион.
+   * @return Quat Единичный кватернион; единичное вращение для нулевого.
+   */
+  static Quat normalize(Quat q);
+
+  /**
+   * @brief Переводит углы calculateRotationMatrix в кватернион.
+   *
+   * @param xAngle Угол вращения вокруг оси X в градусах.
+   * @param yAngle Угол вращения вокруг оси Y в градусах.
+   * @param zAngle Угол вращения вокруг оси Z в градусах.
+   * @return Quat Вращение, совпадающее с calculateRotationMatrix.
+   */
+  static Quat eulerRotation(float xAngle, float yAngle, float zAngle);
+
+  /**
+   * @brief Находит точку виртуального шара под курсором.
+   *
+   * Внутри круга радиуса 1/sqrt(2) точка лежит на сфере, снаружи - на
+   * гиперболе, поэтому вращение непрерывно и у края окна.
+   *
+   * @param x Горизонтальная координата курсора в [-1, 1].
+   * @param y Вертикальная координата курсора в [-1, 1].
+   * @return Vec4f Единичный вектор к точке шара.
+   */
+  static Vec4f arcballPoint(float x, float y);
+
+  /**
+   * @brief Находит кратчайшее вращение от одного единичного вектора
+   * к другому.
+   *
+   * @param from Начальный вектор.
+   * @param to Конечный вектор.
+   * @return Quat Вращение, переводящее from в to.
+   */
+  static Quat arc(Vec4f from, Vec4f to);
 
- private:
   /**
    * @brief Умножает две матрицы.
    *
+   * Результат может совпадать с любым из множителей.
+   *
    * @param a Первая матрица.
    * @param b Вторая матрица.
    * @param result Результирующая матрица.
    */
-  void multiply(float *a, float *b, float *result);
+  static void multiply(const float *a, const float *b, float *result);
+
+ private:
+  /**
+   * @brief Устанавливает масштаб модели, сохраняя положение её центра.
+   *
+   * @param scale Новый масштаб.
+   */
+  void scaleModelAround(float scale);
+
+  /// Признаки изменённых матриц.
+  enum Dirty : unsigned {
+    kModelDirty = 1u << 0,
+    kRotationDirty = 1u << 1,
+    kViewDirty = 1u << 2,
+    kProjectionDirty = 1u << 3,
+    /// MVP перезаписана пошаговыми multMvp* и не совпадает с кэшем.
+    kMvpDirty = 1u << 4,
+    kAllDirty = (1u << 5) - 1
+  };
 
-  float *modelMatrix_;       ///< Матрица модели.
-  float *viewMatrix_;        ///< Матрица вида.
-  float *projectionMatrix_;  ///< Матрица проекции.
-  float *mvpMatrix_;         ///< MVP матрица.
-  float *rotationMatrix_;    ///< Матрица вращения.
+  Mat4f modelMatrix_{};       ///< Матрица модели.
+  Mat4f viewMatrix_{};        ///< Матрица вида.
+  Mat4f projectionMatrix_{};  ///< Матрица проекции.
+  Mat4f mvpMatrix_{};         ///< MVP матрица.
+  Mat4f rotationMatrix_{};    ///< Матрица вращения.
+  Mat4f modelRotation_{};     ///< Кэш model * rotation.
+  Mat4f viewProjection_{};    ///< Кэш view * projection.
+  Vec3f fitCenter_{};         ///< Центр границ, вписанных в экран.
+  unsigned dirty_ = kAllDirty;  ///< Изменённые с прошлого updateMvp.
 };
 
 }  // namespace s21
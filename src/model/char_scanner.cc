@@ -0,0 +1,127 @@
+#include "char_scanner.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define S21_SCANNER_X86 1
+#endif
+
+namespace s21 {
+namespace {
+CharScanner::Masks scanScalar(const char *block, std::size_t size) {
+  CharScanner::Masks masks{};
+  for (std::size_t i = 0; i < size; i++) {
+    std::uint64_t bit = std::uint64_t{1} << i;
+    char c = block[i];
+    if (c == '\n') masks.newline |= bit;
+    if (c == ' ' || c == '\t') masks.space |= bit;
+    if (c == '/') masks.slash |= bit;
+  }
+  return masks;
+}
+
+#ifdef S21_SCANNER_X86
+CharScanner::Masks scanSse2(const char *block) {
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i slash = _mm_set1_epi8('/');
+  CharScanner::Masks masks{};
+  for (int i = 0; i < 4; i++) {
+    __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i * 16));
+    __m128i spaces = _mm_or_si128(_mm_cmpeq_epi8(bytes, space),
+                                  _mm_cmpeq_epi8(bytes, tab));
+    int shift = i * 16;
+    masks.newline |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(
+                         _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline))))
+                     << shift;
+    masks.space |= static_cast<std::uint64_t>(
+                       static_cast<std::uint16_t>(_mm_movemask_epi8(spaces)))
+                   << shift;
+    masks.slash |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(
+                       _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, slash))))
+                   << shift;
+  }
+  return masks;
+}
+
+__attribute__((target("avx2"))) CharScanner::Masks scanAvx2(
+    const char *block) {
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i slash = _mm256_set1_epi8('/');
+  CharScanner::Masks masks{};
+  for (int i = 0; i < 2; i++) {
+    __m256i bytes =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + i * 32));
+    __m256i spaces = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, space),
+                                     _mm256_cmpeq_epi8(bytes, tab));
+    int shift = i * 32;
+    __m256i newlines = _mm256_cmpeq_epi8(bytes, newline);
+    masks.newline |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(
+                         _mm256_movemask_epi8(newlines)))
+                     << shift;
+    masks.space |= static_cast<std::uint64_t>(
+                       static_cast<std::uint32_t>(_mm256_movemask_epi8(spaces)))
+                   << shift;
+    masks.slash |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(
+                       _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, slash))))
+                   << shift;
+  }
+  return masks;
+}
+#endif
+
+}  // namespace
+
+CharScanner::CharScanner()
+    : begin_{nullptr}, end_{nullptr}, masks_{}, isa_{detect()} {}
+
+CharScanner::CharScanner(const char *begin, const char *end) : CharScanner() {
+  reset(begin, end);
+}
+
+void CharScanner::reset(const char *begin, const char *end) {
+  begin_ = begin;
+  end_ = end;
+  std::size_t size = static_cast<std::size_t>(end - begin);
+  masks_.resize((size + kBlockSize - 1) / kBlockSize);
+  for (std::size_t i = 0; i < masks_.size(); i++) {
+    std::size_t offset = i * kBlockSize;
+    std::size_t left = size - offset;
+    masks_[i] =
+        scan(begin + offset, left < kBlockSize ? left : kBlockSize, isa_);
+  }
+}
+
+CharScanner::Masks CharScanner::scan(const char *block, std::size_t size,
+                                     Isa isa) {
+#ifdef S21_SCANNER_X86
+  if (size == kBlockSize) {
+    if (isa == kAvx2) return scanAvx2(block);
+    if (isa == kSse2) return scanSse2(block);
+  }
+#else
+  (void)isa;
+#endif
+  return scanScalar(block, size);
+}
+
+bool CharScanner::supported(Isa isa) {
+#ifdef S21_SCANNER_X86
+  if (isa == kAvx2) return __builtin_cpu_supports("avx2");
+  if (isa == kSse2) return __builtin_cpu_supports("sse2");
+  return true;
+#else
+  return isa == kScalar;
+#endif
+}
+
+CharScanner::Isa CharScanner::detect() {
+  static const Isa best = supported(kAvx2)   ? kAvx2
+                          : supported(kSse2) ? kSse2
+                                             : kScalar;
+  return best;
+}
+}  // namespace s21
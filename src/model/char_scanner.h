@@ -0,0 +1,152 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_CHAR_SCANNER_H_
+#define VIEWER_FRONT_SRC_MODEL_CHAR_SCANNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace s21 {
+/**
+ * @brief Поиск разделителей OBJ-текста блоками по 64 байта.
+ *
+ * Для каждого блока текста заранее строятся битовые маски позиций
+ * перевода строки, пробельных символов и косой черты. Маски считаются
+ * векторными инструкциями (AVX2 или SSE2, выбор по возможностям процессора
+ * при запуске), после чего поиск разделителя сводится к выборке маски и
+ * подсчёту младших нулевых битов, без перебора символов по одному.
+ */
+class CharScanner {
+ public:
+  /**
+   * @brief Класс искомых символов.
+   */
+  enum Kind { kNewline, kSpace, kSlash };
+
+  /**
+   * @brief Набор инструкций для построения масок.
+   */
+  enum Isa { kScalar, kSse2, kAvx2 };
+
+  /**
+   * @brief Маски блока: бит i установлен, если байт i относится к классу.
+   */
+  struct Masks {
+    std::uint64_t newline;  ///< Символы '\n'.
+    std::uint64_t space;    ///< Символы ' ' и '\t'.
+    std::uint64_t slash;    ///< Символы '/'.
+  };
+
+  /**
+   * @brief Размер блока в байтах.
+   */
+  static constexpr std::size_t kBlockSize = 64;
+
+  /**
+   * @brief Создаёт пустой сканер.
+   */
+  CharScanner();
+
+  /**
+   * @brief Создаёт сканер текста и строит маски всех его блоков.
+   *
+   * @param begin Начало текста.
+   * @param end Конец текста; байты за ним не читаются.
+   */
+  CharScanner(const char *begin, const char *end);
+
+  /**
+   * @brief Переключает сканер на другой текст, сохраняя выделенную память.
+   *
+   * @param begin Начало текста.
+   * @param end Конец текста; байты за ним не читаются.
+   */
+  void reset(const char *begin, const char *end);
+
+  /**
+   * @brief Находит ближайший символ класса, начиная с позиции.
+   *
+   * @param from Позиция начала поиска внутри текста.
+   * @param kind Класс символа.
+   * @return const char* Найденный символ или конец текста.
+   */
+  const char *next(const char *from, Kind kind) const {
+    return next(from, kind, end_);
+  }
+
+  /**
+   * @brief Находит ближайший символ класса до заданной границы.
+   *
+   * Маски за границей не просматриваются, поэтому поиск символа, которого
+   * в строке нет, не уходит до конца всего текста.
+   *
+   * @param from Позиция начала поиска внутри текста.
+   * @param kind Класс символа.
+   * @param limit Граница поиска внутри текста.
+   * @return const char* Найденный символ или limit.
+   */
+  const char *next(const char *from, Kind kind, const char *limit) const {
+    if (from >= limit) return limit;
+    std::size_t offset = static_cast<std::size_t>(from - begin_);
+    std::size_t block = offset / kBlockSize;
+    std::size_t last =
+        static_cast<std::size_t>(limit - begin_ - 1) / kBlockSize;
+    std::uint64_t mask = select(masks_[block], kind) &
+                         (~std::uint64_t{0} << (offset % kBlockSize));
+    while (mask == 0) {
+      if (block++ == last) return limit;
+      mask = select(masks_[block], kind);
+    }
+    const char *found = begin_ + block * kBlockSize + countTrailingZeros(mask);
+    return found < limit ? found : limit;
+  }
+
+  /**
+   * @brief Строит маски блока заданным набором инструкций.
+   *
+   * @param block Начало блока.
+   * @param size Количество доступных байт (не больше kBlockSize).
+   * @param isa Набор инструкций; должен поддерживаться процессором.
+   * @return Masks Маски блока; биты за пределами size нулевые.
+   */
+  static Masks scan(const char *block, std::size_t size, Isa isa);
+
+  /**
+   * @brief Проверяет, поддерживает ли процессор набор инструкций.
+   *
+   * @param isa Набор инструкций.
+   * @return bool true, если набор доступен.
+   */
+  static bool supported(Isa isa);
+
+  /**
+   * @brief Возвращает лучший доступный набор инструкций.
+   *
+   * @return Isa Набор, используемый сканером.
+   */
+  static Isa detect();
+
+ private:
+  static std::uint64_t select(const Masks &masks, Kind kind) {
+    return kind == kNewline ? masks.newline
+           : kind == kSpace ? masks.space
+                            : masks.slash;
+  }
+
+  static int countTrailingZeros(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#else
+    int count = 0;
+    for (; (value & 1) == 0; value >>= 1) count++;
+    return count;
+#endif
+  }
+
+  const char *begin_;         ///< Начало текста.
+  const char *end_;           ///< Конец текста.
+  std::vector<Masks> masks_;  ///< Маски блоков текста.
+  Isa isa_;                   ///< Используемый набор инструкций.
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_CHAR_SCANNER_H_
@@ -0,0 +1,209 @@
+#include "decompressor.h"
+
+#include <zlib.h>
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#ifdef S21_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace s21 {
+namespace {
+/// Размер буфера чтения сжатого файла.
+constexpr unsigned int kInputSize = 256u << 10;
+
+bool endsWith(const std::string &text, const std::string &suffix) {
+  return text.size() >= suffix.size() &&
+         text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+}  // namespace
+
+Decompressor::Format Decompressor::detect(const std::string &filename) {
+  if (endsWith(filename, ".gz")) return kGzip;
+  if (endsWith(filename, ".zst")) return kZstd;
+  return kNone;
+}
+
+bool Decompressor::supported(Format format) {
+#ifdef S21_WITH_ZSTD
+  return format == kGzip || format == kZstd;
+#else
+  return format == kGzip;
+#endif
+}
+
+Decompressor::Decompressor(const std::string &filename, Format format,
+                           std::size_t depth)
+    : filename_{filename},
+      format_{format},
+      depth_{depth == 0 ? 1 : depth},
+      compressedSize_{},
+      expectedSize_{},
+      consumed_{},
+      open_{},
+      mutex_{},
+      changed_{},
+      blocks_{},
+      finished_{},
+      stopped_{},
+      error_{},
+      worker_{} {
+  if (!supported(format_)) throw std::invalid_argument("Error in file parse");
+  std::ifstream file(filename_, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) return;
+  compressedSize_ = static_cast<std::size_t>(file.tellg());
+  unsigned char tail[4]{};
+  if (format_ == kGzip && compressedSize_ >= 18 &&
+      file.seekg(-4, std::ios::end).read(reinterpret_cast<char *>(tail), 4)) {
+    expectedSize_ = static_cast<std::size_t>(tail[0]) |
+                    static_cast<std::size_t>(tail[1]) << 8 |
+                    static_cast<std::size_t>(tail[2]) << 16 |
+                    static_cast<std::size_t>(tail[3]) << 24;
+  }
+#ifdef S21_WITH_ZSTD
+  char header[ZSTD_FRAMEHEADERSIZE_MAX]{};
+  if (format_ == kZstd) {
+    file.seekg(0).read(header, sizeof(header));
+    unsigned long long size = ZSTD_getFrameContentSize(
+        header, static_cast<std::size_t>(file.gcount()));
+    if (size != ZSTD_CONTENTSIZE_UNKNOWN && size != ZSTD_CONTENTSIZE_ERROR)
+      expectedSize_ = static_cast<std::size_t>(size);
+  }
+#endif
+  open_ = true;
+  worker_ = std::thread(&Decompressor::run, this);
+}
+
+Decompressor::~Decompressor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  changed_.notify_all();
+  if (worker_.joinable()) worker_.join();
+}
+
+bool Decompressor::isOpen() const { return open_; }
+
+bool Decompressor::next(std::string &block) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_.wait(lock, [this] { return !blocks_.empty() || finished_; });
+  if (blocks_.empty()) {
+    if (error_) std::rethrow_exception(error_);
+    return false;
+  }
+  block = std::move(blocks_.front());
+  blocks_.pop_front();
+  lock.unlock();
+  changed_.notify_all();
+  return true;
+}
+
+bool Decompressor::ready() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return !blocks_.empty() || finished_;
+}
+
+std::size_t Decompressor::compressedSize() const { return compressedSize_; }
+
+std::size_t Decompressor::consumedBytes() const { return consumed_; }
+
+std::size_t Decompressor::expectedSize() const { return expectedSize_; }
+
+void Decompressor::run() {
+  try {
+    if (format_ == kGzip)
+      inflateGzip();
+    else
+      decompressZstd();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    error_ = std::current_exception();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_ = true;
+  }
+  changed_.notify_all();
+}
+
+void Decompressor::inflateGzip() {
+  gzFile file = gzopen(filename_.c_str(), "rb");
+  if (file == nullptr) throw std::invalid_argument("Error in file parse");
+  gzbuffer(file, kInputSize);
+  bool failed = false;
+  while (true) {
+    std::string block(kBlockSize, '\0');
+    int read = gzread(file, block.data(), static_cast<unsigned>(kBlockSize));
+    if (read <= 0) {
+      // Обрезанный файл zlib отмечает ошибкой Z_BUF_ERROR.
+      int code = Z_OK;
+      gzerror(file, &code);
+      failed = read < 0 || code != Z_OK;
+      break;
+    }
+    block.resize(static_cast<std::size_t>(read));
+    consumed_ = static_cast<std::size_t>(gzoffset(file));
+    if (!push(std::move(block))) break;
+  }
+  consumed_ = compressedSize_;
+  gzclose(file);
+  if (failed) throw std::invalid_argument("Error in file parse");
+}
+
+void Decompressor::decompressZstd() {
+#ifdef S21_WITH_ZSTD
+  std::ifstream file(filename_, std::ios::binary);
+  if (!file.is_open()) throw std::invalid_argument("Error in file parse");
+  std::unique_ptr<ZSTD_DStream, std::size_t (*)(ZSTD_DStream *)> stream(
+      ZSTD_createDStream(), ZSTD_freeDStream);
+  ZSTD_initDStream(stream.get());
+  std::string input(ZSTD_DStreamInSize(), '\0');
+  std::string block(kBlockSize, '\0');
+  ZSTD_outBuffer out{block.data(), block.size(), 0};
+  std::size_t pending = 0;
+  bool more = true;
+  while (more) {
+    file.read(input.data(), static_cast<std::streamsize>(input.size()));
+    std::size_t size = static_cast<std::size_t>(file.gcount());
+    more = size > 0;
+    ZSTD_inBuffer in{input.data(), size, 0};
+    // Заполненный блок может означать, что в декодере остался вывод,
+    // поэтому после него декодер вызывается ещё раз.
+    bool flush = true;
+    while (in.pos < in.size || flush) {
+      pending = ZSTD_decompressStream(stream.get(), &out, &in);
+      if (ZSTD_isError(pending))
+        throw std::invalid_argument("Error in file parse");
+      flush = out.pos == out.size;
+      if (flush) {
+        if (!push(std::move(block))) return;
+        block.assign(kBlockSize, '\0');
+        out = ZSTD_outBuffer{block.data(), block.size(), 0};
+      }
+    }
+    consumed_ += size;
+  }
+  // Ненулевой остаток означает, что кадр оборвался.
+  if (pending != 0) throw std::invalid_argument("Error in file parse");
+  block.resize(out.pos);
+  if (!block.empty()) push(std::move(block));
+#else
+  throw std::invalid_argument("Error in file parse");
+#endif
+}
+
+bool Decompressor::push(std::string block) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_.wait(lock, [this] { return blocks_.size() < depth_ || stopped_; });
+  if (stopped_) return false;
+  blocks_.push_back(std::move(block));
+  lock.unlock();
+  changed_.notify_all();
+  return true;
+}
+}  // namespace s21
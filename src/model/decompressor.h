@@ -0,0 +1,157 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_DECOMPRESSOR_H_
+#define VIEWER_FRONT_SRC_MODEL_DECOMPRESSOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace s21 {
+/**
+ * @brief Потоковая распаковка сжатого OBJ-файла в отдельном потоке.
+ *
+ * Фоновый поток читает сжатый файл и складывает распакованный текст
+ * блоками фиксированного размера в ограниченную очередь; разборщик
+ * забирает блоки по мере готовности. Распаковка и разбор идут
+ * одновременно, а распакованный файл целиком в памяти не хранится.
+ */
+class Decompressor {
+ public:
+  /**
+   * @brief Формат сжатия файла.
+   */
+  enum Format { kNone, kGzip, kZstd };
+
+  /// Размер блока распакованного текста.
+  static constexpr std::size_t kBlockSize = std::size_t{4} << 20;
+
+  /**
+   * @brief Определяет формат сжатия по расширению (.gz, .zst).
+   *
+   * @param filename Имя файла.
+   * @return Format Формат; kNone для несжатого файла.
+   */
+  static Format detect(const std::string &filename);
+
+  /**
+   * @brief Проверяет, собрана ли поддержка формата.
+   *
+   * @param format Формат сжатия.
+   * @return bool true, если файлы этого формата можно распаковать.
+   */
+  static bool supported(Format format);
+
+  /**
+   * @brief Открывает файл и запускает распаковку.
+   *
+   * @param filename Имя сжатого файла.
+   * @param format Формат сжатия.
+   * @param depth Наибольшее количество распакованных блоков в очереди.
+   * @throw std::invalid_argument Если формат не поддерживается.
+   */
+  Decompressor(const std::string &filename, Format format,
+               std::size_t depth = 4);
+
+  /**
+   * @brief Останавливает распаковку и дожидается фонового потока.
+   */
+  ~Decompressor();
+
+  Decompressor(const Decompressor &) = delete;
+  Decompressor &operator=(const Decompressor &) = delete;
+
+  /**
+   * @brief Проверяет, удалось ли открыть файл.
+   *
+   * @return bool true, если распаковка запущена.
+   */
+  [[nodiscard]] bool isOpen() const;
+
+  /**
+   * @brief Забирает очередной блок распакованного текста.
+   *
+   * Ждёт, пока фоновый поток распакует блок.
+   *
+   * @param block Блок; прежнее содержимое заменяется.
+   * @return bool false, если файл распакован целиком.
+   * @throw std::invalid_argument Если сжатые данные повреждены.
+   */
+  bool next(std::string &block);
+
+  /**
+   * @brief Проверяет, можно ли забрать блок без ожидания.
+   *
+   * @return bool true, если в очереди есть блок или распаковка окончена.
+   */
+  [[nodiscard]] bool ready() const;
+
+  /**
+   * @brief Возвращает размер сжатого файла.
+   *
+   * @return std::size_t Размер в байтах.
+   */
+  [[nodiscard]] std::size_t compressedSize() const;
+
+  /**
+   * @brief Возвращает количество прочитанных сжатых байт.
+   *
+   * @return std::size_t Количество байт, уже поданных на распаковку.
+   */
+  [[nodiscard]] std::size_t consumedBytes() const;
+
+  /**
+   * @brief Возвращает размер распакованного текста, записанный в файле.
+   *
+   * Для gzip берётся из завершения файла (по модулю 2^32), для zstd - из
+   * заголовка кадра.
+   *
+   * @return std::size_t Размер в байтах; 0, если неизвестен.
+   */
+  [[nodiscard]] std::size_t expectedSize() const;
+
+ private:
+  /**
+   * @brief Тело фонового потока.
+   */
+  void run();
+
+  /**
+   * @brief Распаковывает gzip-файл.
+   */
+  void inflateGzip();
+
+  /**
+   * @brief Распаковывает zstd-файл.
+   */
+  void decompressZstd();
+
+  /**
+   * @brief Кладёт блок в очередь, дожидаясь места в ней.
+   *
+   * @param block Блок распакованного текста.
+   * @return bool false, если распаковку нужно прекратить.
+   */
+  bool push(std::string block);
+
+  std::string filename_;                ///< Имя сжатого файла.
+  Format format_;                       ///< Формат сжатия.
+  std::size_t depth_;                   ///< Ёмкость очереди.
+  std::size_t compressedSize_;          ///< Размер сжатого файла.
+  std::size_t expectedSize_;            ///< Размер распакованного текста.
+  std::atomic<std::size_t> consumed_;   ///< Прочитано сжатых байт.
+  bool open_;                           ///< Файл открыт.
+  mutable std::mutex mutex_;            ///< Защита очереди.
+  std::condition_variable changed_;     ///< Изменение очереди.
+  std::deque<std::string> blocks_;      ///< Распакованные блоки.
+  bool finished_;                       ///< Распаковка окончена.
+  bool stopped_;                        ///< Запрошена остановка.
+  std::exception_ptr error_;            ///< Ошибка распаковки.
+  std::thread worker_;                  ///< Фоновый поток.
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_DECOMPRESSOR_H_
@@ -0,0 +1,149 @@
+#include "edge_extractor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "obj_model.h"
+#include "thread_pool.h"
+
+namespace s21 {
+namespace {
+/// Количество элементов, обрабатываемых одной задачей.
+constexpr std::size_t kBlockSize = std::size_t{1} << 16;
+/// Разрядность цифры поразрядной сортировки.
+constexpr int kDigitBits = 8;
+constexpr std::size_t kBuckets = std::size_t{1} << kDigitBits;
+
+std::size_t blockCount(std::size_t size) {
+  return (size + kBlockSize - 1) / kBlockSize;
+}
+
+int bitWidth(std::uint64_t value) {
+  int bits = 0;
+  for (; value != 0; value >>= 1) bits++;
+  return bits;
+}
+}  // namespace
+
+std::vector<int> EdgeExtractor::extract(const std::vector<int> &outlines,
+                                        ThreadPool &pool) {
+  std::size_t keyCount = outlines.size();
+  std::size_t blocks = blockCount(keyCount);
+  std::vector<int> blockMax(blocks, -1);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t begin = block * kBlockSize;
+    std::size_t end = std::min(begin + kBlockSize, keyCount);
+    blockMax[block] =
+        *std::max_element(outlines.begin() + begin, outlines.begin() + end);
+  });
+  int maxIndex = blocks == 0 ? -1 : *std::max_element(blockMax.begin(),
+                                                      blockMax.end());
+  if (maxIndex < 0) return {};
+
+  // Индексы занимают bits разрядов; отбрасываемые рёбра получают ключ
+  // (limit, limit), который больше любого настоящего и после сортировки
+  // оказывается в конце.
+  std::uint64_t limit = static_cast<std::uint64_t>(maxIndex) + 1;
+  int bits = bitWidth(limit);
+  std::uint64_t skipped = (limit << bits) | limit;
+  // Ключ i описывает ребро от вершины i к следующей вершине контура;
+  // последняя вершина грани замыкается на первую.
+  std::vector<std::uint64_t> keys(keyCount);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t begin = block * kBlockSize;
+    std::size_t end = std::min(begin + kBlockSize, keyCount);
+    for (std::size_t i = begin; i < end; i++) {
+      int a = outlines[i];
+      int b = a;
+      if (i + 1 < keyCount && outlines[i + 1] != kPrimitiveRestart) {
+        b = outlines[i + 1];
+      } else {
+        std::size_t first = i;
+        while (first > 0 && outlines[first - 1] != kPrimitiveRestart) first--;
+        b = outlines[first];
+      }
+      if (a > b) std::swap(a, b);
+      keys[i] = (a < 0 || a == b) ? skipped
+                                  : (static_cast<std::uint64_t>(a) << bits) |
+                                        static_cast<std::uint64_t>(b);
+    }
+  });
+  radixSort(keys, bits * 2, pool);
+
+  // Уникальные ключи собираются параллельно: сначала каждая задача
+  // считает свои первые вхождения, затем пишет их по смещению из
+  // префиксной суммы.
+  std::vector<std::size_t> offsets(blocks + 1);
+  auto isFirst = [&](std::size_t i) {
+    return keys[i] != skipped && (i == 0 || keys[i] != keys[i - 1]);
+  };
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t begin = block * kBlockSize;
+    std::size_t end = std::min(begin + kBlockSize, keyCount);
+    std::size_t count = 0;
+    for (std::size_t i = begin; i < end; i++) count += isFirst(i);
+    offsets[block + 1] = count;
+  });
+  for (std::size_t block = 0; block < blocks; block++)
+    offsets[block + 1] += offsets[block];
+
+  std::vector<int> lines(offsets.back() * 2);
+  const std::uint64_t mask = (std::uint64_t{1} << bits) - 1;
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t begin = block * kBlockSize;
+    std::size_t end = std::min(begin + kBlockSize, keyCount);
+    int *out = lines.data() + offsets[block] * 2;
+    for (std::size_t i = begin; i < end; i++) {
+      if (!isFirst(i)) continue;
+      *out++ = static_cast<int>(keys[i] >> bits);
+      *out++ = static_cast<int>(keys[i] & mask);
+    }
+  });
+  return lines;
+}
+
+void EdgeExtractor::radixSort(std::vector<std::uint64_t> &keys, int bits,
+                              ThreadPool &pool) {
+  std::size_t blocks = blockCount(keys.size());
+  std::vector<std::uint64_t> buffer(keys.size());
+  std::vector<std::size_t> counts(blocks * kBuckets);
+
+  for (int shift = 0; shift < bits; shift += kDigitBits) {
+    // Гистограммы цифры по блокам.
+    pool.run(blocks, [&](std::size_t block) {
+      std::size_t *count = counts.data() + block * kBuckets;
+      std::fill(count, count + kBuckets, 0);
+      std::size_t end = std::min((block + 1) * kBlockSize, keys.size());
+      for (std::size_t i = block * kBlockSize; i < end; i++)
+        count[(keys[i] >> shift) & (kBuckets - 1)]++;
+    });
+
+    // Смещения: цифры по возрастанию, внутри цифры блоки по порядку,
+    // что сохраняет устойчивость сортировки. Проход, в котором у всех
+    // ключей одна и та же цифра, ничего не меняет и пропускается.
+    std::size_t offset = 0;
+    bool trivial = false;
+    for (std::size_t digit = 0; digit < kBuckets; digit++) {
+      std::size_t digitTotal = 0;
+      for (std::size_t block = 0; block < blocks; block++) {
+        std::size_t &count = counts[block * kBuckets + digit];
+        std::size_t inBlock = count;
+        count = offset;
+        offset += inBlock;
+        digitTotal += inBlock;
+      }
+      if (digitTotal == keys.size()) trivial = true;
+    }
+    if (trivial) continue;
+
+    pool.run(blocks, [&](std::size_t block) {
+      std::size_t *position = counts.data() + block * kBuckets;
+      std::size_t end = std::min((block + 1) * kBlockSize, keys.size());
+      for (std::size_t i = block * kBlockSize; i < end; i++)
+        buffer[position[(keys[i] >> shift) & (kBuckets - 1)]++] = keys[i];
+    });
+    keys.swap(buffer);
+  }
+}
+}  // namespace s21
@@ -0,0 +1,46 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_EDGE_EXTRACTOR_H_
+#define VIEWER_FRONT_SRC_MODEL_EDGE_EXTRACTOR_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace s21 {
+class ThreadPool;
+
+/**
+ * @brief Выделение уникальных неориентированных рёбер сетки.
+ *
+ * Каждое ребро контура грани кодируется 64-битным ключом (min, max), ключи
+ * сортируются параллельной поразрядной сортировкой, после чего соседние
+ * повторы отбрасываются. Ребро, общее для двух граней, попадает в
+ * результат один раз, поэтому каркас, нарисованный отрезками, растеризует
+ * каждое ребро однократно, а диагонали триангуляции в него не входят.
+ */
+class EdgeExtractor {
+ public:
+  /**
+   * @brief Выделяет уникальные рёбра контуров граней.
+   *
+   * Вырожденные рёбра и рёбра с отрицательными индексами пропускаются.
+   *
+   * @param outlines Контуры граней, разделённые kPrimitiveRestart.
+   * @param pool Пул потоков.
+   * @return std::vector<int> Пары индексов (min, max) для GL_LINES,
+   * упорядоченные по возрастанию.
+   */
+  static std::vector<int> extract(const std::vector<int> &outlines,
+                                  ThreadPool &pool);
+
+  /**
+   * @brief Сортирует ключи по возрастанию младших битов.
+   *
+   * @param keys Ключи; старшие биты за пределами bits должны совпадать.
+   * @param bits Количество значащих младших битов ключа.
+   * @param pool Пул потоков.
+   */
+  static void radixSort(std::vector<std::uint64_t> &keys, int bits,
+                        ThreadPool &pool);
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_EDGE_EXTRACTOR_H_
@@ -0,0 +1,230 @@
+#include "linear_algebra.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define S21_LINEAR_ALGEBRA_X86 1
+#endif
+
+namespace s21 {
+namespace {
+#ifdef S21_LINEAR_ALGEBRA_X86
+/**
+ * @brief Умножает матрицы по строкам: строка результата - сумма строк b,
+ * взвешенных элементами той же строки a.
+ *
+ * Все загрузки выполняются до записи, поэтому result может совпадать
+ * с a или b.
+ */
+void multiplySse(const float *a, const float *b, float *result) {
+  __m128 rows[4], out[4];
+  for (int i = 0; i < 4; i++) rows[i] = _mm_loadu_ps(b + i * 4);
+  for (int r = 0; r < 4; r++) {
+    __m128 row = _mm_loadu_ps(a + r * 4);
+    out[r] = _mm_add_ps(
+        _mm_add_ps(
+            _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)),
+                       rows[0]),
+            _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)),
+                       rows[1])),
+        _mm_add_ps(
+            _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)),
+                       rows[2]),
+            _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)),
+                       rows[3])));
+  }
+  for (int r = 0; r < 4; r++) _mm_storeu_ps(result + r * 4, out[r]);
+}
+
+/**
+ * @brief То же, что multiplySse, но две строки a обрабатываются одним
+ * регистром AVX: каждая строка b повторяется в обеих половинах.
+ */
+__attribute__((target("avx2"))) void multiplyAvx2(const float *a,
+                                                  const float *b,
+                                                  float *result) {
+  __m256 rows[4], out[2];
+  for (int i = 0; i < 4; i++)
+    rows[i] = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + i * 4));
+  for (int half = 0; half < 2; half++) {
+    __m256 pair = _mm256_loadu_ps(a + half * 8);
+    out[half] = _mm256_add_ps(
+        _mm256_add_ps(
+            _mm256_mul_ps(_mm256_permute_ps(pair, _MM_SHUFFLE(0, 0, 0, 0)),
+                          rows[0]),
+            _mm256_mul_ps(_mm256_permute_ps(pair, _MM_SHUFFLE(1, 1, 1, 1)),
+                          rows[1])),
+        _mm256_add_ps(
+            _mm256_mul_ps(_mm256_permute_ps(pair, _MM_SHUFFLE(2, 2, 2, 2)),
+                          rows[2]),
+            _mm256_mul_ps(_mm256_permute_ps(pair, _MM_SHUFFLE(3, 3, 3, 3)),
+                          rows[3])));
+  }
+  _mm256_storeu_ps(result, out[0]);
+  _mm256_storeu_ps(result + 8, out[1]);
+}
+
+/**
+ * @brief Преобразует точки по одной: результат - сумма столбцов матрицы,
+ * взвешенных координатами точки.
+ *
+ * Записываются ровно три float, чтобы не задеть следующую точку, если
+ * out совпадает с in.
+ */
+void transformSse(const float *m, const float *in, float *out,
+                  std::size_t count, bool project) {
+  __m128 c0 = _mm_loadu_ps(m), c1 = _mm_loadu_ps(m + 4);
+  __m128 c2 = _mm_loadu_ps(m + 8), c3 = _mm_loadu_ps(m + 12);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  for (std::size_t i = 0; i < count; i++) {
+    const float *point = in + i * 3;
+    __m128 sum = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(point[0])),
+                   _mm_mul_ps(c1, _mm_set1_ps(point[1]))),
+        _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(point[2])), c3));
+    if (project)
+      sum = _mm_div_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(3, 3, 3, 3)));
+    _mm_storel_pi(reinterpret_cast<__m64 *>(out + i * 3), sum);
+    _mm_store_ss(out + i * 3 + 2, _mm_movehl_ps(sum, sum));
+  }
+}
+
+/**
+ * @brief Преобразует точки по восемь.
+ *
+ * 24 float загружаются в три регистра так, что в каждой половине
+ * оказываются четыре точки подряд, и перестановками внутри половин
+ * раскладываются на регистры x, y и z. Элементы матрицы размножены
+ * по регистрам, поэтому строка результата - три умножения и три
+ * сложения. Обратные перестановки собирают точки обратно.
+ *
+ * @return std::size_t Количество обработанных точек, кратное восьми.
+ */
+__attribute__((target("avx2"))) std::size_t transformAvx2(
+    const float *m, const float *in, float *out, std::size_t count,
+    bool project) {
+  __m256 e[16];
+  for (int i = 0; i < 16; i++) e[i] = _mm256_set1_ps(m[i]);
+  std::size_t done = count / 8 * 8;
+  for (std::size_t i = 0; i < done; i += 8) {
+    const float *p = in + i * 3;
+    // Половины: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 для точек 0-3
+    // и то же для точек 4-7.
+    __m256 m03 = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+    __m256 m14 = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+    __m256 m25 = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+    __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+    __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+    __m256 x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    __m256 y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    __m256 z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+
+    __m256 row[4];
+    for (int r = 0; r < (project ? 4 : 3); r++) {
+      row[r] = _mm256_add_ps(
+          _mm256_add_ps(_mm256_mul_ps(e[r * 4], x),
+                        _mm256_mul_ps(e[r * 4 + 1], y)),
+          _mm256_add_ps(_mm256_mul_ps(e[r * 4 + 2], z), e[r * 4 + 3]));
+    }
+    if (project) {
+      for (int r = 0; r < 3; r++) row[r] = _mm256_div_ps(row[r], row[3]);
+    }
+
+    __m256 rxy = _mm256_shuffle_ps(row[0], row[1], _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 ryz = _mm256_shuffle_ps(row[1], row[2], _MM_SHUFFLE(3, 1, 3, 1));
+    __m256 rzx = _mm256_shuffle_ps(row[2], row[0], _MM_SHUFFLE(3, 1, 2, 0));
+    m03 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+    m14 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+    m25 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+    float *q = out + i * 3;
+    _mm_storeu_ps(q, _mm256_castps256_ps128(m03));
+    _mm_storeu_ps(q + 4, _mm256_castps256_ps128(m14));
+    _mm_storeu_ps(q + 8, _mm256_castps256_ps128(m25));
+    _mm_storeu_ps(q + 12, _mm256_extractf128_ps(m03, 1));
+    _mm_storeu_ps(q + 16, _mm256_extractf128_ps(m14, 1));
+    _mm_storeu_ps(q + 20, _mm256_extractf128_ps(m25, 1));
+  }
+  return done;
+}
+
+bool hasAvx2() {
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+}
+#endif
+}  // namespace
+
+void multiplyMatrices(const float *a, const float *b, float *result) {
+#ifdef S21_LINEAR_ALGEBRA_X86
+  if (hasAvx2()) {
+    multiplyAvx2(a, b, result);
+  } else {
+    multiplySse(a, b, result);
+  }
+#else
+  float out[16];
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      float sum = 0.0;
+      for (int i = 0; i < 4; ++i) {
+        sum += a[row * 4 + i] * b[i * 4 + col];
+      }
+      out[row * 4 + col] = sum;
+    }
+  }
+  std::copy(out, out + 16, result);
+#endif
+}
+
+void transformVector(const float *a, const float *v, float *result) {
+#ifdef S21_LINEAR_ALGEBRA_X86
+  // После транспонирования в регистрах столбцы, и произведение - сумма
+  // столбцов, взвешенных координатами вектора.
+  __m128 c0 = _mm_loadu_ps(a), c1 = _mm_loadu_ps(a + 4);
+  __m128 c2 = _mm_loadu_ps(a + 8), c3 = _mm_loadu_ps(a + 12);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  __m128 sum = _mm_add_ps(
+      _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(v[0])),
+                 _mm_mul_ps(c1, _mm_set1_ps(v[1]))),
+      _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(v[2])),
+                 _mm_mul_ps(c3, _mm_set1_ps(v[3]))));
+  _mm_storeu_ps(result, sum);
+#else
+  float out[4];
+  for (int row = 0; row < 4; row++)
+    out[row] = a[row * 4] * v[0] + a[row * 4 + 1] * v[1] +
+               a[row * 4 + 2] * v[2] + a[row * 4 + 3] * v[3];
+  std::copy(out, out + 4, result);
+#endif
+}
+
+void transformPoints(const float *matrix, const float *in, float *out,
+                     std::size_t count, bool project) {
+#ifdef S21_LINEAR_ALGEBRA_X86
+  std::size_t done = 0;
+  if (hasAvx2()) done = transformAvx2(matrix, in, out, count, project);
+  transformSse(matrix, in + done * 3, out + done * 3, count - done, project);
+#else
+  const float *m = matrix;
+  for (std::size_t i = 0; i < count; i++) {
+    float x = in[i * 3], y = in[i * 3 + 1], z = in[i * 3 + 2];
+    float rx = m[0] * x + m[1] * y + m[2] * z + m[3];
+    float ry = m[4] * x + m[5] * y + m[6] * z + m[7];
+    float rz = m[8] * x + m[9] * y + m[10] * z + m[11];
+    if (project) {
+      float w = m[12] * x + m[13] * y + m[14] * z + m[15];
+      rx /= w;
+      ry /= w;
+      rz /= w;
+    }
+    out[i * 3] = rx;
+    out[i * 3 + 1] = ry;
+    out[i * 3 + 2] = rz;
+  }
+#endif
+}
+}  // namespace s21
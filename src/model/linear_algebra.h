@@ -0,0 +1,362 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_LINEAR_ALGEBRA_H_
+#define VIEWER_FRONT_SRC_MODEL_LINEAR_ALGEBRA_H_
+
+#include <cstddef>
+#include <type_traits>
+
+namespace s21 {
+/**
+ * @brief Квадратный корень, вычислимый при компиляции.
+ *
+ * Метод Ньютона в double; для float результат округляется один раз
+ * и совпадает с std::sqrt.
+ *
+ * @param value Неотрицательное число.
+ * @return T Корень из value; ноль для неположительных и NaN.
+ */
+template <typename T>
+constexpr T squareRoot(T value) {
+  double x = static_cast<double>(value);
+  if (!(x > 0.0)) return T{0};
+  // Начиная сверху, итерации убывают до корня; первая неубывающая
+  // означает, что точность double исчерпана.
+  double root = x >= 1.0 ? x : 1.0;
+  for (;;) {
+    double next = 0.5 * (root + x / root);
+    if (next >= root) break;
+    root = next;
+  }
+  return static_cast<T>(root);
+}
+
+/**
+ * @brief Вектор в 3D пространстве.
+ */
+template <typename T>
+struct Vec3 {
+  T x;  ///< Координата по оси X.
+  T y;  ///< Координата по оси Y.
+  T z;  ///< Координата по оси Z.
+};
+
+/**
+ * @brief Вектор в однородных координатах.
+ *
+ * Выравнивание по размеру вектора позволяет загружать его одним
+ * регистром SSE для float и AVX для double.
+ */
+template <typename T>
+struct alignas(4 * sizeof(T)) Vec4 {
+  T x;  ///< Координата по оси X.
+  T y;  ///< Координата по оси Y.
+  T z;  ///< Координата по оси Z.
+  T w;  ///< Четвёртая координата (обычно используется для однородных
+        ///< координат).
+};
+
+/**
+ * @brief Матрица 4x4, хранимая по строкам; вектор умножается справа.
+ *
+ * Матрица - значение без памяти в куче, выровненное так же, как Vec4,
+ * чтобы строка загружалась одним регистром.
+ */
+template <typename T>
+struct alignas(4 * sizeof(T)) Mat4 {
+  T m[16];  ///< Элементы матрицы.
+
+  /**
+   * @brief Создаёт единичную матрицу.
+   *
+   * @return Mat4 Единичная матрица.
+   */
+  static constexpr Mat4 identity() {
+    return Mat4{{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}};
+  }
+
+  constexpr T &operator[](int i) { return m[i]; }
+  constexpr const T &operator[](int i) const { return m[i]; }
+};
+
+using Vec3f = Vec3<float>;
+using Vec3d = Vec3<double>;
+using Vec4f = Vec4<float>;
+using Vec4d = Vec4<double>;
+using Mat4f = Mat4<float>;
+using Mat4d = Mat4<double>;
+
+/**
+ * @brief Умножает матрицы float векторными регистрами.
+ *
+ * Строки результата копятся в регистрах SSE (по две строки в регистре
+ * AVX, если процессор его поддерживает) и записываются после чтения
+ * обоих множителей, поэтому result может совпадать с a или b.
+ *
+ * @param a Левый множитель, 16 элементов по строкам.
+ * @param b Правый множитель, 16 элементов по строкам.
+ * @param result Произведение a * b.
+ */
+void multiplyMatrices(const float *a, const float *b, float *result);
+
+/**
+ * @brief Преобразует вектор float матрицей векторными регистрами.
+ *
+ * @param a Матрица, 16 элементов по строкам.
+ * @param v Вектор из четырёх координат.
+ * @param result Произведение a * v; может совпадать с v.
+ */
+void transformVector(const float *a, const float *v, float *result);
+
+/**
+ * @brief Преобразует массив точек xyz матрицей float.
+ *
+ * Точка дополняется w = 1. С AVX2 восемь точек раскладываются по
+ * регистрам координат и преобразуются вместе, без него каждая точка
+ * занимает один регистр SSE. Точки читаются раньше, чем записываются,
+ * поэтому out может совпадать с in.
+ *
+ * @param matrix Матрица, 16 элементов по строкам.
+ * @param in Координаты точек, по три на точку.
+ * @param out Преобразованные координаты, по три на точку.
+ * @param count Количество точек.
+ * @param project Делить ли x, y, z результата на его w.
+ */
+void transformPoints(const float *matrix, const float *in, float *out,
+                     std::size_t count, bool project);
+
+template <typename T>
+constexpr Vec3<T> operator+(const Vec3<T> &a, const Vec3<T> &b) {
+  return Vec3<T>{a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+template <typename T>
+constexpr Vec3<T> operator-(const Vec3<T> &a, const Vec3<T> &b) {
+  return Vec3<T>{a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+template <typename T>
+constexpr Vec3<T> operator*(const Vec3<T> &v, T scale) {
+  return Vec3<T>{v.x * scale, v.y * scale, v.z * scale};
+}
+
+template <typename T>
+constexpr bool operator==(const Vec3<T> &a, const Vec3<T> &b) {
+  return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+template <typename T>
+constexpr T dot(const Vec3<T> &a, const Vec3<T> &b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+template <typename T>
+constexpr Vec3<T> cross(const Vec3<T> &a, const Vec3<T> &b) {
+  return Vec3<T>{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+                 a.x * b.y - a.y * b.x};
+}
+
+template <typename T>
+constexpr T length(const Vec3<T> &v) {
+  return squareRoot(dot(v, v));
+}
+
+/**
+ * @brief Нормализует вектор.
+ *
+ * @param v Ненулевой вектор.
+ * @return Vec3 Единичный вектор того же направления.
+ */
+template <typename T>
+constexpr Vec3<T> normalize(const Vec3<T> &v) {
+  return v * (T{1} / length(v));
+}
+
+template <typename T>
+constexpr Vec4<T> operator+(const Vec4<T> &a, const Vec4<T> &b) {
+  return Vec4<T>{a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w};
+}
+
+template <typename T>
+constexpr Vec4<T> operator-(const Vec4<T> &a, const Vec4<T> &b) {
+  return Vec4<T>{a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w};
+}
+
+template <typename T>
+constexpr Vec4<T> operator*(const Vec4<T> &v, T scale) {
+  return Vec4<T>{v.x * scale, v.y * scale, v.z * scale, v.w * scale};
+}
+
+template <typename T>
+constexpr bool operator==(const Vec4<T> &a, const Vec4<T> &b) {
+  return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+}
+
+template <typename T>
+constexpr T dot(const Vec4<T> &a, const Vec4<T> &b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+template <typename T>
+constexpr bool operator==(const Mat4<T> &a, const Mat4<T> &b) {
+  for (int i = 0; i < 16; i++)
+    if (a.m[i] != b.m[i]) return false;
+  return true;
+}
+
+/**
+ * @brief Умножает матрицы float ядром multiplyMatrices.
+ *
+ * Отдельная функция не constexpr, поэтому результат не обнуляется
+ * перед записью: на каждом кадре это заметная доля времени умножения.
+ */
+inline Mat4<float> multiplyAtRuntime(const Mat4<float> &a,
+                                     const Mat4<float> &b) {
+  Mat4<float> result;
+  multiplyMatrices(a.m, b.m, result.m);
+  return result;
+}
+
+/**
+ * @brief Преобразует вектор float ядром transformVector без обнуления
+ * результата.
+ */
+inline Vec4<float> transformAtRuntime(const Mat4<float> &a,
+                                      const Vec4<float> &v) {
+  Vec4<float> result;
+  transformVector(a.m, &v.x, &result.x);
+  return result;
+}
+
+/**
+ * @brief Умножает две матрицы.
+ *
+ * При вычислении во время выполнения матрицы float умножаются
+ * ядром multiplyMatrices, остальные - скалярным циклом. Запись вида
+ * a = a * b безопасна.
+ *
+ * @param a Левый множитель.
+ * @param b Правый множитель.
+ * @return Mat4 Произведение a * b.
+ */
+template <typename T>
+constexpr Mat4<T> operator*(const Mat4<T> &a, const Mat4<T> &b) {
+  if constexpr (std::is_same_v<T, float>) {
+    if (!__builtin_is_constant_evaluated()) return multiplyAtRuntime(a, b);
+  }
+  Mat4<T> result{};
+  for (int row = 0; row < 4; row++) {
+    for (int col = 0; col < 4; col++) {
+      T sum{};
+      for (int i = 0; i < 4; i++) sum += a.m[row * 4 + i] * b.m[i * 4 + col];
+      result.m[row * 4 + col] = sum;
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Преобразует вектор матрицей.
+ *
+ * @param a Матрица.
+ * @param v Вектор в однородных координатах.
+ * @return Vec4 Произведение a * v.
+ */
+template <typename T>
+constexpr Vec4<T> operator*(const Mat4<T> &a, const Vec4<T> &v) {
+  if constexpr (std::is_same_v<T, float>) {
+    if (!__builtin_is_constant_evaluated()) return transformAtRuntime(a, v);
+  }
+  const T in[4] = {v.x, v.y, v.z, v.w};
+  T out[4] = {};
+  for (int row = 0; row < 4; row++)
+    for (int i = 0; i < 4; i++) out[row] += a.m[row * 4 + i] * in[i];
+  return Vec4<T>{out[0], out[1], out[2], out[3]};
+}
+
+template <typename T>
+constexpr Mat4<T> transpose(const Mat4<T> &a) {
+  Mat4<T> result{};
+  for (int row = 0; row < 4; row++)
+    for (int col = 0; col < 4; col++)
+      result.m[col * 4 + row] = a.m[row * 4 + col];
+  return result;
+}
+
+/**
+ * @brief Строит матрицу переноса.
+ *
+ * @param offset Вектор переноса.
+ * @return Mat4 Матрица, прибавляющая offset к точке.
+ */
+template <typename T>
+constexpr Mat4<T> translation(const Vec3<T> &offset) {
+  Mat4<T> result = Mat4<T>::identity();
+  result.m[3] = offset.x;
+  result.m[7] = offset.y;
+  result.m[11] = offset.z;
+  return result;
+}
+
+/**
+ * @brief Строит матрицу равномерного масштабирования.
+ *
+ * @param scale Множитель по всем осям.
+ * @return Mat4 Матрица масштабирования.
+ */
+template <typename T>
+constexpr Mat4<T> scaling(T scale) {
+  Mat4<T> result = Mat4<T>::identity();
+  result.m[0] = result.m[5] = result.m[10] = scale;
+  return result;
+}
+
+/**
+ * @brief Строит матрицу перспективной проекции по границам пирамиды
+ * видимости, как glFrustum.
+ *
+ * @param left Левая граница на ближней плоскости.
+ * @param right Правая граница на ближней плоскости.
+ * @param bottom Нижняя граница на ближней плоскости.
+ * @param top Верхняя граница на ближней плоскости.
+ * @param near Расстояние до ближней плоскости отсечения.
+ * @param far Расстояние до дальней плоскости отсечения.
+ * @return Mat4 Матрица проекции.
+ */
+template <typename T>
+constexpr Mat4<T> frustum(T left, T right, T bottom, T top, T near, T far) {
+  Mat4<T> result{};
+  result.m[0] = T{2} * near / (right - left);
+  result.m[2] = (right + left) / (right - left);
+  result.m[5] = T{2} * near / (top - bottom);
+  result.m[6] = (top + bottom) / (top - bottom);
+  result.m[10] = -(far + near) / (far - near);
+  result.m[11] = -(T{2} * far * near) / (far - near);
+  result.m[14] = T{-1};
+  return result;
+}
+
+/**
+ * @brief Строит матрицу ортографической проекции, как glOrtho.
+ *
+ * @param left Левая граница.
+ * @param right Правая граница.
+ * @param bottom Нижняя граница.
+ * @param top Верхняя граница.
+ * @param near Расстояние до ближней плоскости отсечения.
+ * @param far Расстояние до дальней плоскости отсечения.
+ * @return Mat4 Матрица проекции.
+ */
+template <typename T>
+constexpr Mat4<T> ortho(T left, T right, T bottom, T top, T near, T far) {
+  Mat4<T> result{};
+  result.m[0] = T{2} / (right - left);
+  result.m[3] = -(right + left) / (right - left);
+  result.m[5] = T{2} / (top - bottom);
+  result.m[7] = -(top + bottom) / (top - bottom);
+  result.m[10] = T{-2} / (far - near);
+  result.m[11] = -(far + near) / (far - near);
+  result.m[15] = T{1};
+  return result;
+}
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_LINEAR_ALGEBRA_H_
@@ -0,0 +1,42 @@
+#include "load_progress.h"
+
+namespace s21 {
+LoadProgress::LoadProgress() : done_{}, total_{}, cancelled_{false} {}
+
+void LoadProgress::setTotal(std::size_t bytes) {
+  total_.store(bytes, std::memory_order_relaxed);
+}
+
+void LoadProgress::advance(std::size_t bytes) {
+  done_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void LoadProgress::finish() {
+  std::size_t total = total_.load(std::memory_order_relaxed);
+  if (total == 0) {
+    total = 1;
+    total_.store(total, std::memory_order_relaxed);
+  }
+  done_.store(total, std::memory_order_relaxed);
+}
+
+double LoadProgress::fraction() const {
+  std::size_t total = total_.load(std::memory_order_relaxed);
+  if (total == 0) return 0.0;
+  double value =
+      static_cast<double>(done_.load(std::memory_order_relaxed)) / total;
+  return value < 1.0 ? value : 1.0;
+}
+
+void LoadProgress::cancel() {
+  cancelled_.store(true, std::memory_order_relaxed);
+}
+
+bool LoadProgress::cancelled() const {
+  return cancelled_.load(std::memory_order_relaxed);
+}
+
+void LoadProgress::throwIfCancelled() const {
+  if (cancelled()) throw LoadCancelled();
+}
+}  // namespace s21
@@ -0,0 +1,78 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_LOAD_PROGRESS_H_
+#define VIEWER_FRONT_SRC_MODEL_LOAD_PROGRESS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+namespace s21 {
+/**
+ * @brief Исключение, которым прерывается отменённая загрузка модели.
+ */
+class LoadCancelled : public std::runtime_error {
+ public:
+  LoadCancelled() : std::runtime_error("Model loading cancelled") {}
+};
+
+/**
+ * @brief Прогресс загрузки модели, общий для загрузчика и интерфейса.
+ *
+ * Разборщик отмечает обработанные байты файла и периодически проверяет
+ * запрос отмены; интерфейс читает долю выполненной работы из другого
+ * потока.
+ */
+class LoadProgress {
+ public:
+  LoadProgress();
+
+  /**
+   * @brief Задаёт общий объём работы в байтах.
+   *
+   * @param bytes Размер входных данных.
+   */
+  void setTotal(std::size_t bytes);
+
+  /**
+   * @brief Отмечает обработанные байты.
+   *
+   * @param bytes Количество байт, обработанных с прошлого вызова.
+   */
+  void advance(std::size_t bytes);
+
+  /**
+   * @brief Отмечает загрузку как полностью выполненную.
+   */
+  void finish();
+
+  /**
+   * @brief Возвращает долю выполненной работы.
+   *
+   * @return double Значение от 0 до 1.
+   */
+  [[nodiscard]] double fraction() const;
+
+  /**
+   * @brief Запрашивает отмену загрузки.
+   */
+  void cancel();
+
+  /**
+   * @brief Проверяет, запрошена ли отмена.
+   *
+   * @return bool true, если загрузку нужно прервать.
+   */
+  [[nodiscard]] bool cancelled() const;
+
+  /**
+   * @brief Бросает LoadCancelled, если запрошена отмена.
+   */
+  void throwIfCancelled() const;
+
+ private:
+  std::atomic<std::size_t> done_;   ///< Обработано байт.
+  std::atomic<std::size_t> total_;  ///< Всего байт.
+  std::atomic<bool> cancelled_;     ///< Признак запроса отмены.
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_LOAD_PROGRESS_H_
@@ -0,0 +1,44 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace s21 {
+MappedFile::MappedFile(const std::string &filename)
+    : data_{nullptr}, size_{}, open_{false} {
+  // Тип проверяется до open(): открытие канала заблокировало бы поток и
+  // отняло бы данные у последующего потокового чтения.
+  struct stat info {};
+  if (::stat(filename.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) return;
+
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) return;
+
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ == 0) {
+    open_ = true;
+  } else {
+    void *data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      ::madvise(data, size_, MADV_SEQUENTIAL);
+      data_ = data;
+      open_ = true;
+    } else {
+      size_ = 0;
+    }
+  }
+  ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) ::munmap(data_, size_);
+}
+
+bool MappedFile::isOpen() const { return open_; }
+
+std::string_view MappedFile::view() const {
+  return {static_cast<const char *>(data_), size_};
+}
+}  // namespace s21
@@ -0,0 +1,56 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_MAPPED_FILE_H_
+#define VIEWER_FRONT_SRC_MODEL_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace s21 {
+/**
+ * @brief Файл, отображённый в память только для чтения.
+ *
+ * Содержимое доступно через std::string_view без копирования в буферы
+ * потоков. Для последовательного чтения ядру передаётся подсказка
+ * MADV_SEQUENTIAL. Отображаются только обычные файлы: для каналов и
+ * устройств isOpen() возвращает false, и вызывающий код должен читать их
+ * потоком.
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Отображает файл в память.
+   *
+   * @param filename Путь к файлу.
+   */
+  explicit MappedFile(const std::string &filename);
+
+  /**
+   * @brief Снимает отображение.
+   */
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /**
+   * @brief Проверяет, удалось ли отобразить файл.
+   *
+   * @return bool true, если содержимое доступно через view().
+   */
+  [[nodiscard]] bool isOpen() const;
+
+  /**
+   * @brief Возвращает содержимое файла.
+   *
+   * @return std::string_view Байты файла; пустой для пустого файла.
+   */
+  [[nodiscard]] std::string_view view() const;
+
+ private:
+  void *data_;        ///< Адрес отображения.
+  std::size_t size_;  ///< Размер отображения в байтах.
+  bool open_;         ///< Признак успешного отображения.
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_MAPPED_FILE_H_
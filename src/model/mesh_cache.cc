@@ -0,0 +1,249 @@
+#include "mesh_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+#include "load_progress.h"
+#include "mapped_file.h"
+#include "obj_model.h"
+
+namespace s21 {
+namespace {
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'E', 'S', 'H', '\0'};
+constexpr std::uint32_t kVersion = 5;
+constexpr std::size_t kFullHashLimit = std::size_t{4} << 20;
+constexpr std::size_t kEdgeWindow = std::size_t{1} << 20;
+constexpr std::size_t kSampleWindow = std::size_t{16} << 10;
+constexpr std::size_t kSampleCount = 64;
+/// Размер части, после которой проверяется отмена при хэшировании и
+/// записи.
+constexpr std::size_t kCancelStep = std::size_t{1} << 20;
+
+/**
+ * @brief Заголовок файла кэша; за ним следуют вершины, треугольники,
+ * контуры граней и уникальные рёбра.
+ */
+struct CacheHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t headerSize;
+  std::uint64_t pathHash;
+  std::uint64_t sourceSize;
+  std::int64_t sourceMtime;
+  std::uint64_t contentHash;
+  std::uint64_t vertexFloats;
+  std::uint64_t edgeCount;
+  std::uint64_t outlineCount;
+  std::uint64_t lineCount;
+  std::uint32_t vertexCount;
+  std::uint32_t facetsCount;
+  float bounds[6];
+  float center[3];
+  float radius;
+  float weldTolerance;
+  std::uint32_t weldRemoved;
+};
+
+std::uint64_t hashBytes(std::string_view bytes, std::uint64_t hash) {
+  constexpr std::uint64_t kPrime = 0x100000001b3ULL;
+  std::size_t i = 0;
+  for (; i + 8 <= bytes.size(); i += 8) {
+    std::uint64_t word{};
+    std::memcpy(&word, bytes.data() + i, 8);
+    hash = (hash ^ word) * kPrime;
+    hash ^= hash >> 29;
+  }
+  for (; i < bytes.size(); i++) {
+    hash = (hash ^ static_cast<unsigned char>(bytes[i])) * kPrime;
+  }
+  return hash;
+}
+
+void checkCancelled(const LoadProgress *progress) {
+  if (progress != nullptr) progress->throwIfCancelled();
+}
+
+/**
+ * @brief Записывает массив частями, проверяя отмену между ними.
+ */
+void writeArray(std::ofstream &file, const void *data, std::size_t bytes,
+                const LoadProgress *progress) {
+  const char *cursor = static_cast<const char *>(data);
+  for (std::size_t done = 0; done < bytes; done += kCancelStep) {
+    checkCancelled(progress);
+    file.write(cursor + done, static_cast<std::streamsize>(
+                                  std::min(kCancelStep, bytes - done)));
+  }
+}
+
+/**
+ * @brief Допуск сварки в том виде, в котором он хранится в кэше: все
+ * отрицательные значения означают выключенную сварку.
+ */
+float weldKey(float tolerance) {
+  return tolerance >= 0.0f ? tolerance : -1.0f;
+}
+}  // namespace
+
+std::string MeshCache::cachePath(const std::string &filename) {
+  return filename + "cache";
+}
+
+bool MeshCache::sourceKey(const std::string &filename, SourceKey &key,
+                          const LoadProgress *progress) {
+  std::error_code error{};
+  auto mtime = std::filesystem::last_write_time(filename, error);
+  if (error) return false;
+  MappedFile source(filename);
+  if (!source.isOpen()) return false;
+
+  std::string_view bytes = source.view();
+  constexpr std::uint64_t kOffsetBasis = 0xcbf29ce484222325ULL;
+  std::uint64_t hash = kOffsetBasis;
+  if (bytes.size() <= kFullHashLimit) {
+    // Части кратны восьми байтам, поэтому хэш совпадает с хэшем целого.
+    for (std::size_t i = 0; i < bytes.size(); i += kCancelStep) {
+      checkCancelled(progress);
+      hash = hashBytes(bytes.substr(i, kCancelStep), hash);
+    }
+  } else {
+    hash = hashBytes(bytes.substr(0, kEdgeWindow), hash);
+    hash = hashBytes(bytes.substr(bytes.size() - kEdgeWindow), hash);
+    std::size_t step = (bytes.size() - kSampleWindow) / kSampleCount;
+    for (std::size_t i = 1; i < kSampleCount; i++) {
+      checkCancelled(progress);
+      hash = hashBytes(bytes.substr(i * step, kSampleWindow), hash);
+    }
+  }
+
+  std::string path =
+      std::filesystem::absolute(filename, error).lexically_normal().string();
+  key.pathHash = hashBytes(path, kOffsetBasis);
+  key.size = bytes.size();
+  key.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+  key.contentHash = hash;
+  return true;
+}
+
+bool MeshCache::load(const std::string &filename, Model &model) {
+  MappedFile cache(cachePath(filename));
+  if (!cache.isOpen()) return false;
+  std::string_view bytes = cache.view();
+  if (bytes.size() < sizeof(CacheHeader)) return false;
+
+  CacheHeader header{};
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  SourceKey key{};
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.headerSize != sizeof(header) ||
+      !sourceKey(filename, key, model.options_.progress) ||
+      header.pathHash != key.pathHash ||
+      header.sourceSize != key.size || header.sourceMtime != key.mtime ||
+      header.contentHash != key.contentHash ||
+      header.weldTolerance != weldKey(model.options_.weldTolerance) ||
+      bytes.size() != sizeof(header) + header.vertexFloats * sizeof(float) +
+                          (header.edgeCount + header.outlineCount +
+                           header.lineCount) *
+                              sizeof(int)) {
+    return false;
+  }
+
+  const char *data = bytes.data() + sizeof(header);
+  model.vertexes_.resize(header.vertexFloats);
+  std::memcpy(model.vertexes_.data(), data,
+              header.vertexFloats * sizeof(float));
+  data += header.vertexFloats * sizeof(float);
+  model.edges_.resize(header.edgeCount);
+  std::memcpy(model.edges_.data(), data, header.edgeCount * sizeof(int));
+  data += header.edgeCount * sizeof(int);
+  model.outlines_.resize(header.outlineCount);
+  std::memcpy(model.outlines_.data(), data,
+              header.outlineCount * sizeof(int));
+  data += header.outlineCount * sizeof(int);
+  model.lines_.resize(header.lineCount);
+  std::memcpy(model.lines_.data(), data, header.lineCount * sizeof(int));
+
+  model.vertexCount_ = header.vertexCount;
+  model.facetsCount_ = header.facetsCount;
+  model.minX_ = header.bounds[0];
+  model.maxX_ = header.bounds[1];
+  model.minY_ = header.bounds[2];
+  model.maxY_ = header.bounds[3];
+  model.minZ_ = header.bounds[4];
+  model.maxZ_ = header.bounds[5];
+  model.centerX_ = header.center[0];
+  model.centerY_ = header.center[1];
+  model.centerZ_ = header.center[2];
+  model.radius_ = header.radius;
+  model.weldStats_.vertexesAfter = header.vertexFloats / 3;
+  model.weldStats_.vertexesBefore =
+      model.weldStats_.vertexesAfter + header.weldRemoved;
+  model.weldStats_.savedBytes = header.weldRemoved * 3 * sizeof(float);
+  return true;
+}
+
+bool MeshCache::save(const std::string &filename, const Model &model,
+                     const LoadProgress *progress) {
+  SourceKey key{};
+  if (!sourceKey(filename, key, progress)) return false;
+
+  CacheHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.headerSize = sizeof(header);
+  header.pathHash = key.pathHash;
+  header.sourceSize = key.size;
+  header.sourceMtime = key.mtime;
+  header.contentHash = key.contentHash;
+  header.vertexFloats = model.vertexes_.size();
+  header.edgeCount = model.edges_.size();
+  header.outlineCount = model.outlines_.size();
+  header.lineCount = model.lines_.size();
+  header.vertexCount = model.vertexCount_;
+  header.facetsCount = model.facetsCount_;
+  float bounds[6] = {model.minX_, model.maxX_, model.minY_,
+                     model.maxY_, model.minZ_, model.maxZ_};
+  float center[3] = {model.centerX_, model.centerY_, model.centerZ_};
+  std::memcpy(header.bounds, bounds, sizeof(bounds));
+  std::memcpy(header.center, center, sizeof(center));
+  header.radius = model.radius_;
+  header.weldTolerance = weldKey(model.options_.weldTolerance);
+  header.weldRemoved = static_cast<std::uint32_t>(
+      model.weldStats_.vertexesBefore - model.weldStats_.vertexesAfter);
+
+  std::string path = cachePath(filename);
+  std::string tmpPath = path + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    try {
+      writeArray(file, model.vertexes_.data(),
+                 model.vertexes_.size() * sizeof(float), progress);
+      writeArray(file, model.edges_.data(), model.edges_.size() * sizeof(int),
+                 progress);
+      writeArray(file, model.outlines_.data(),
+                 model.outlines_.size() * sizeof(int), progress);
+      writeArray(file, model.lines_.data(), model.lines_.size() * sizeof(int),
+                 progress);
+    } catch (const LoadCancelled &) {
+      file.close();
+      std::remove(tmpPath.c_str());
+      throw;
+    }
+    if (!file.good()) {
+      file.close();
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+  std::error_code error{};
+  std::filesystem::rename(tmpPath, path, error);
+  if (error) std::remove(tmpPath.c_str());
+  return !error;
+}
+}  // namespace s21
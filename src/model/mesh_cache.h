@@ -0,0 +1,84 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_MESH_CACHE_H_
+#define VIEWER_FRONT_SRC_MODEL_MESH_CACHE_H_
+
+#include <cstdint>
+#include <string>
+
+namespace s21 {
+class LoadProgress;
+class Model;
+
+/**
+ * @brief Двоичный кэш разобранной модели (файл .objcache рядом с OBJ).
+ *
+ * Кэш хранит вершины, индексы, границы и счётчики модели. Он привязан к
+ * пути, размеру, времени изменения и хэшу содержимого исходного файла;
+ * при несовпадении любого из ключей кэш игнорируется. При чтении кэш
+ * отображается в память, поэтому повторное открытие не требует разбора
+ * текста.
+ */
+class MeshCache {
+ public:
+  /**
+   * @brief Возвращает путь к кэшу для OBJ-файла.
+   *
+   * @param filename Путь к OBJ-файлу.
+   * @return std::string Путь вида "model.objcache".
+   */
+  static std::string cachePath(const std::string &filename);
+
+  /**
+   * @brief Загружает модель из кэша, если он соответствует файлу.
+   *
+   * @param filename Путь к OBJ-файлу.
+   * @param model Модель, заполняемая данными кэша.
+   * @return bool true, если кэш найден и актуален.
+   */
+  static bool load(const std::string &filename, Model &model);
+
+  /**
+   * @brief Сохраняет разобранную модель в кэш.
+   *
+   * Файл сначала пишется во временный, затем переименовывается, поэтому
+   * прерванная запись не оставляет повреждённого кэша. Ошибки записи
+   * (например, каталог только для чтения) не считаются ошибкой загрузки.
+   * Между частями записи проверяется отмена загрузки модели; при отмене
+   * временный файл удаляется и выбрасывается LoadCancelled.
+   *
+   * @param filename Путь к OBJ-файлу.
+   * @param model Разобранная модель.
+   * @param progress Прогресс загрузки или nullptr.
+   * @return bool true, если кэш записан.
+   */
+  static bool save(const std::string &filename, const Model &model,
+                   const LoadProgress *progress = nullptr);
+
+ private:
+  /**
+   * @brief Ключ, связывающий кэш с исходным файлом.
+   */
+  struct SourceKey {
+    std::uint64_t pathHash;     ///< Хэш пути к файлу.
+    std::uint64_t size;         ///< Размер файла в байтах.
+    std::int64_t mtime;         ///< Время изменения файла.
+    std::uint64_t contentHash;  ///< Хэш содержимого файла.
+  };
+
+  /**
+   * @brief Вычисляет ключ исходного файла.
+   *
+   * Содержимое хэшируется выборочно: начало, конец и 64 равномерно
+   * распределённых окна, чтобы проверка большого файла занимала
+   * миллисекунды. Между окнами проверяется отмена загрузки.
+   *
+   * @param filename Путь к OBJ-файлу.
+   * @param key Вычисленный ключ.
+   * @param progress Прогресс загрузки или nullptr.
+   * @return bool true, если файл доступен.
+   */
+  static bool sourceKey(const std::string &filename, SourceKey &key,
+                        const LoadProgress *progress);
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_MESH_CACHE_H_
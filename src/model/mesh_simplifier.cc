@@ -0,0 +1,669 @@
+#include "mesh_simplifier.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+
+#include "bounding_box.h"
+#include "edge_extractor.h"
+#include "load_progress.h"
+#include "thread_pool.h"
+
+namespace s21 {
+namespace {
+/// Примерное количество треугольников одного участка.
+constexpr std::size_t kPartitionTriangles = std::size_t{1} << 15;
+/// Наибольшее количество участков.
+constexpr std::size_t kMaxPartitions = 4096;
+/// Количество вершин или треугольников, обрабатываемых одной задачей.
+constexpr std::size_t kBlockSize = std::size_t{1} << 16;
+/// Вершина ещё не встречалась ни в одном участке.
+constexpr int kUnowned = -1;
+/// Вершина принадлежит нескольким участкам и закреплена.
+constexpr int kShared = -2;
+/// Вес плоскостей, удерживающих открытые края сетки.
+constexpr double kBorderWeight = 10.0;
+/// Частота проверки отмены, в схлопываниях.
+constexpr std::size_t kCancelCheck = 4096;
+
+void cross(const double a[3], const double b[3], double out[3]) {
+  out[0] = a[1] * b[2] - a[2] * b[1];
+  out[1] = a[2] * b[0] - a[0] * b[2];
+  out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+double dot(const double a[3], const double b[3]) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/**
+ * @brief Нормаль треугольника, не нормированная.
+ */
+void triangleNormal(const double *p0, const double *p1, const double *p2,
+                    double normal[3]) {
+  double u[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+  double v[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+  cross(u, v, normal);
+}
+
+/**
+ * @brief Квадрика ошибки: симметричная матрица 4x4, хранимая верхним
+ * треугольником (a00 a01 a02 a03 a11 a12 a13 a22 a23 a33).
+ */
+struct Quadric {
+  double a[10]{};
+
+  void addPlane(const double normal[3], double d, double weight) {
+    const double n0 = normal[0], n1 = normal[1], n2 = normal[2];
+    a[0] += weight * n0 * n0;
+    a[1] += weight * n0 * n1;
+    a[2] += weight * n0 * n2;
+    a[3] += weight * n0 * d;
+    a[4] += weight * n1 * n1;
+    a[5] += weight * n1 * n2;
+    a[6] += weight * n1 * d;
+    a[7] += weight * n2 * n2;
+    a[8] += weight * n2 * d;
+    a[9] += weight * d * d;
+  }
+
+  void add(const Quadric &other) {
+    for (int i = 0; i < 10; i++) a[i] += other.a[i];
+  }
+
+  /// Сумма квадратов расстояний от точки до плоскостей квадрики.
+  [[nodiscard]] double evaluate(const double p[3]) const {
+    const double x = p[0], y = p[1], z = p[2];
+    return a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z +
+           2 * a[3] * x + a[4] * y * y + 2 * a[5] * y * z + 2 * a[6] * y +
+           a[7] * z * z + 2 * a[8] * z + a[9];
+  }
+
+  /// Точка минимума; false, если матрица вырождена.
+  bool minimum(double p[3]) const {
+    double c00 = a[4] * a[7] - a[5] * a[5];
+    double c01 = a[2] * a[5] - a[1] * a[7];
+    double c02 = a[1] * a[5] - a[2] * a[4];
+    double det = a[0] * c00 + a[1] * c01 + a[2] * c02;
+    double trace = a[0] + a[4] + a[7];
+    if (!(trace > 0.0) || std::fabs(det) < 1e-3 * trace * trace * trace)
+      return false;
+    double c11 = a[0] * a[7] - a[2] * a[2];
+    double c12 = a[1] * a[2] - a[0] * a[5];
+    double c22 = a[0] * a[4] - a[1] * a[1];
+    double b[3] = {-a[3], -a[6], -a[8]};
+    p[0] = (c00 * b[0] + c01 * b[1] + c02 * b[2]) / det;
+    p[1] = (c01 * b[0] + c11 * b[1] + c12 * b[2]) / det;
+    p[2] = (c02 * b[0] + c12 * b[1] + c22 * b[2]) / det;
+    return std::isfinite(p[0] + p[1] + p[2]);
+  }
+};
+
+/**
+ * @brief Кандидат на схлопывание ребра remove -> keep в точку pos.
+ */
+struct Collapse {
+  double cost;
+  int keep, remove;
+  unsigned int keepVersion, removeVersion;
+  double pos[3];
+
+  bool operator>(const Collapse &other) const { return cost > other.cost; }
+};
+
+/**
+ * @brief Упрощение одного пространственного участка сетки.
+ *
+ * Работает в локальной нумерации вершин участка; закреплённые вершины
+ * не сдвигаются и не удаляются.
+ */
+class Partition {
+ public:
+  Partition(const std::vector<float> &vertexes, std::vector<int> corners,
+            const std::atomic<int> *owners, int id)
+      : corners_(std::move(corners)) {
+    global_ = corners_;
+    std::sort(global_.begin(), global_.end());
+    global_.erase(std::unique(global_.begin(), global_.end()), global_.end());
+    for (int &corner : corners_) {
+      corner = static_cast<int>(
+          std::lower_bound(global_.begin(), global_.end(), corner) -
+          global_.begin());
+    }
+
+    std::size_t count = global_.size();
+    pos_.resize(count * 3);
+    locked_.resize(count);
+    removed_.resize(count);
+    version_.resize(count);
+    quadrics_.resize(count);
+    adjacency_.resize(count);
+    for (std::size_t v = 0; v < count; v++) {
+      for (int axis = 0; axis < 3; axis++)
+        pos_[v * 3 + axis] = vertexes[global_[v] * 3 + axis];
+      locked_[v] = owners != nullptr &&
+                   owners[global_[v]].load(std::memory_order_relaxed) != id;
+    }
+    dead_.resize(corners_.size() / 3);
+    alive_ = dead_.size();
+  }
+
+  /**
+   * @brief Схлопывает рёбра, пока треугольников больше target.
+   */
+  void simplify(std::size_t target, const LoadProgress *progress) {
+    addQuadrics();
+    std::size_t collapses = 0;
+    while (alive_ > target && !heap_.empty()) {
+      Collapse collapse = heap_.top();
+      heap_.pop();
+      if (removed_[collapse.keep] || removed_[collapse.remove] ||
+          version_[collapse.keep] != collapse.keepVersion ||
+          version_[collapse.remove] != collapse.removeVersion ||
+          flips(collapse))
+        continue;
+      apply(collapse);
+      if (++collapses % kCancelCheck == 0 && progress != nullptr)
+        progress->throwIfCancelled();
+    }
+  }
+
+  /**
+   * @brief Записывает оставшиеся треугольники в глобальной нумерации и
+   * новые координаты вершин участка.
+   */
+  void emit(std::vector<float> &positions, std::vector<unsigned char> &used,
+            std::vector<int> &triangles) const {
+    for (std::size_t v = 0; v < global_.size(); v++) {
+      if (removed_[v] || locked_[v]) continue;
+      used[global_[v]] = 1;
+      for (int axis = 0; axis < 3; axis++)
+        positions[global_[v] * 3 + axis] =
+            static_cast<float>(pos_[v * 3 + axis]);
+    }
+    triangles.reserve(alive_ * 3);
+    for (std::size_t t = 0; t < dead_.size(); t++) {
+      if (dead_[t]) continue;
+      for (int corner = 0; corner < 3; corner++)
+        triangles.push_back(global_[corners_[t * 3 + corner]]);
+    }
+  }
+
+  /// Наибольшая ошибка выполненного схлопывания.
+  [[nodiscard]] double maxCost() const { return maxCost_; }
+
+ private:
+  const double *position(int vertex) const { return &pos_[vertex * 3]; }
+
+  /**
+   * @brief Копит квадрики граней и открытых краёв и заполняет очередь
+   * схлопываний всеми рёбрами участка.
+   */
+  void addQuadrics() {
+    std::vector<std::pair<std::uint64_t, std::size_t>> edges;
+    edges.reserve(corners_.size());
+    for (std::size_t t = 0; t < dead_.size(); t++) {
+      const int *tri = &corners_[t * 3];
+      double normal[3];
+      triangleNormal(position(tri[0]), position(tri[1]), position(tri[2]),
+                     normal);
+      double length = std::sqrt(dot(normal, normal));
+      if (length > 0.0) {
+        for (double &value : normal) value /= length;
+        double d = -dot(normal, position(tri[0]));
+        for (int corner = 0; corner < 3; corner++)
+          quadrics_[tri[corner]].addPlane(normal, d, 1.0);
+      }
+      for (int corner = 0; corner < 3; corner++) {
+        adjacency_[tri[corner]].push_back(static_cast<int>(t));
+        auto a = static_cast<std::uint64_t>(tri[corner]);
+        auto b = static_cast<std::uint64_t>(tri[(corner + 1) % 3]);
+        edges.emplace_back(std::min(a, b) << 32 | std::max(a, b), t);
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (std::size_t i = 0; i < edges.size();) {
+      std::size_t next = i + 1;
+      while (next < edges.size() && edges[next].first == edges[i].first)
+        next++;
+      int a = static_cast<int>(edges[i].first >> 32);
+      int b = static_cast<int>(edges[i].first & 0xFFFFFFFFu);
+      if (next - i == 1) addBorder(a, b, edges[i].second);
+      i = next;
+    }
+    for (std::size_t i = 0; i < edges.size(); i++) {
+      if (i > 0 && edges[i].first == edges[i - 1].first) continue;
+      push(static_cast<int>(edges[i].first >> 32),
+           static_cast<int>(edges[i].first & 0xFFFFFFFFu));
+    }
+  }
+
+  /**
+   * @brief Добавляет плоскость, проходящую через открытый край
+   * перпендикулярно грани, чтобы край не стягивался внутрь.
+   */
+  void addBorder(int a, int b, std::size_t triangle) {
+    const int *tri = &corners_[triangle * 3];
+    double normal[3], edge[3], side[3];
+    triangleNormal(position(tri[0]), position(tri[1]), position(tri[2]),
+                   normal);
+    for (int axis = 0; axis < 3; axis++)
+      edge[axis] = position(b)[axis] - position(a)[axis];
+    cross(edge, normal, side);
+    double length = std::sqrt(dot(side, side));
+    if (!(length > 0.0)) return;
+    for (double &value : side) value /= length;
+    double d = -dot(side, position(a));
+    quadrics_[a].addPlane(side, d, kBorderWeight);
+    quadrics_[b].addPlane(side, d, kBorderWeight);
+  }
+
+  /**
+   * @brief Ставит в очередь схлопывание ребра (a, b).
+   */
+  void push(int a, int b) {
+    if (locked_[a] && locked_[b]) return;
+    Collapse collapse{};
+    collapse.keep = locked_[b] ? b : a;
+    collapse.remove = locked_[b] ? a : b;
+    collapse.keepVersion = version_[collapse.keep];
+    collapse.removeVersion = version_[collapse.remove];
+    Quadric sum = quadrics_[a];
+    sum.add(quadrics_[b]);
+
+    const double *pa = position(collapse.keep);
+    const double *pb = position(collapse.remove);
+    double best[3] = {pa[0], pa[1], pa[2]};
+    if (!locked_[collapse.keep]) {
+      double middle[3], optimum[3];
+      double edgeSquared = 0.0, offsetSquared = 0.0;
+      for (int axis = 0; axis < 3; axis++) {
+        middle[axis] = (pa[axis] + pb[axis]) / 2.0;
+        edgeSquared += (pb[axis] - pa[axis]) * (pb[axis] - pa[axis]);
+      }
+      bool solved = sum.minimum(optimum);
+      for (int axis = 0; solved && axis < 3; axis++)
+        offsetSquared += (optimum[axis] - middle[axis]) *
+                         (optimum[axis] - middle[axis]);
+      // Почти вырожденная квадрика может дать минимум далеко от ребра.
+      if (solved && offsetSquared <= edgeSquared) {
+        std::copy(optimum, optimum + 3, best);
+      } else {
+        double bestCost = sum.evaluate(best);
+        const double *candidates[2] = {pb, middle};
+        for (const double *candidate : candidates) {
+          double cost = sum.evaluate(candidate);
+          if (cost < bestCost) {
+            bestCost = cost;
+            std::copy(candidate, candidate + 3, best);
+          }
+        }
+      }
+    }
+    std::copy(best, best + 3, collapse.pos);
+    collapse.cost = std::max(0.0, sum.evaluate(best));
+    heap_.push(collapse);
+  }
+
+  /**
+   * @brief Проверяет, перевернёт ли схлопывание какой-нибудь треугольник.
+   */
+  bool flips(const Collapse &collapse) const {
+    for (int moved : {collapse.keep, collapse.remove}) {
+      for (int t : adjacency_[moved]) {
+        if (dead_[t]) continue;
+        const int *tri = &corners_[t * 3];
+        bool hasKeep = false, hasRemove = false;
+        const double *after[3];
+        for (int corner = 0; corner < 3; corner++) {
+          hasKeep |= tri[corner] == collapse.keep;
+          hasRemove |= tri[corner] == collapse.remove;
+          after[corner] =
+              tri[corner] == moved ? collapse.pos : position(tri[corner]);
+        }
+        if (hasKeep && hasRemove) continue;
+        double before[3], changed[3];
+        triangleNormal(position(tri[0]), position(tri[1]), position(tri[2]),
+                       before);
+        triangleNormal(after[0], after[1], after[2], changed);
+        if (!(dot(before, changed) > 0.0)) return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Схлопывает ребро и пересчитывает рёбра вокруг оставшейся
+   * вершины.
+   */
+  void apply(const Collapse &collapse) {
+    int keep = collapse.keep, remove = collapse.remove;
+    for (int t : adjacency_[remove]) {
+      if (dead_[t]) continue;
+      int *tri = &corners_[t * 3];
+      if (tri[0] == keep || tri[1] == keep || tri[2] == keep) {
+        dead_[t] = 1;
+        alive_--;
+        continue;
+      }
+      for (int corner = 0; corner < 3; corner++)
+        if (tri[corner] == remove) tri[corner] = keep;
+      adjacency_[keep].push_back(t);
+    }
+    std::vector<int>().swap(adjacency_[remove]);
+    std::vector<int> &around = adjacency_[keep];
+    around.erase(std::remove_if(around.begin(), around.end(),
+                                [this](int t) { return dead_[t] != 0; }),
+                 around.end());
+
+    quadrics_[keep].add(quadrics_[remove]);
+    std::copy(collapse.pos, collapse.pos + 3, &pos_[keep * 3]);
+    removed_[remove] = 1;
+    version_[keep]++;
+    version_[remove]++;
+    maxCost_ = std::max(maxCost_, collapse.cost);
+    neighbours_.clear();
+    for (int t : around) {
+      for (int corner = 0; corner < 3; corner++) {
+        int other = corners_[t * 3 + corner];
+        if (other != keep) neighbours_.push_back(other);
+      }
+    }
+    // Каждая соседка входит в два треугольника вокруг вершины.
+    std::sort(neighbours_.begin(), neighbours_.end());
+    neighbours_.erase(std::unique(neighbours_.begin(), neighbours_.end()),
+                      neighbours_.end());
+    for (int other : neighbours_) push(keep, other);
+  }
+
+  std::vector<int> corners_;  ///< Треугольники в локальной нумерации.
+  std::vector<int> global_;   ///< Глобальные номера локальных вершин.
+  std::vector<double> pos_;   ///< Координаты локальных вершин.
+  std::vector<unsigned char> locked_;   ///< Закреплённые вершины.
+  std::vector<unsigned char> removed_;  ///< Удалённые вершины.
+  std::vector<unsigned int> version_;   ///< Счётчики изменений вершин.
+  std::vector<Quadric> quadrics_;       ///< Квадрики вершин.
+  std::vector<std::vector<int>> adjacency_;  ///< Треугольники вершин.
+  std::vector<unsigned char> dead_;          ///< Удалённые треугольники.
+  std::vector<int> neighbours_;  ///< Соседки вершины после схлопывания.
+  std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>>
+      heap_;                ///< Очередь схлопываний.
+  std::size_t alive_{};     ///< Количество оставшихся треугольников.
+  double maxCost_{};        ///< Наибольшая ошибка схлопывания.
+};
+
+/**
+ * @brief Раздвигает младшие 10 бит через два (для кода Мортона).
+ */
+std::uint32_t spreadBits(std::uint32_t x) {
+  x &= 0x3FF;
+  x = (x | (x << 16)) & 0x030000FF;
+  x = (x | (x << 8)) & 0x0300F00F;
+  x = (x | (x << 4)) & 0x030C30C3;
+  x = (x | (x << 2)) & 0x09249249;
+  return x;
+}
+
+/**
+ * @brief Упорядочивает треугольники по коду Мортона их центров, чтобы
+ * соседние по порядку треугольники были соседями и в пространстве.
+ */
+std::vector<std::uint32_t> mortonOrder(const std::vector<float> &vertexes,
+                                       const std::vector<int> &triangles,
+                                       ThreadPool &pool) {
+  std::size_t count = triangles.size() / 3;
+  BoundingBox box = BoundingBox::compute(vertexes, pool);
+  // Масштаб общий для всех осей: иначе тонкая ось делилась бы так же
+  // мелко, как длинная, и участки плоских моделей распадались бы на
+  // несвязные слои.
+  float extent = 0.0f;
+  for (int axis = 0; axis < 3; axis++)
+    extent = std::max(extent, box.max[axis] - box.min[axis]);
+  float scale = extent > 0.0f ? 1023.0f / extent : 0.0f;
+  std::vector<std::uint64_t> keys(count);
+  std::size_t blocks = (count + kBlockSize - 1) / kBlockSize;
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, count);
+    for (std::size_t t = block * kBlockSize; t < end; t++) {
+      std::uint32_t code = 0;
+      for (int axis = 0; axis < 3; axis++) {
+        float center = 0.0f;
+        for (int corner = 0; corner < 3; corner++)
+          center += vertexes[triangles[t * 3 + corner] * 3 + axis];
+        float cell = (center / 3.0f - box.min[axis]) * scale;
+        auto quantized = static_cast<std::uint32_t>(
+            std::clamp(cell, 0.0f, 1023.0f));
+        code |= spreadBits(quantized) << axis;
+      }
+      keys[t] = static_cast<std::uint64_t>(code) << 32 | t;
+    }
+  });
+  EdgeExtractor::radixSort(keys, 62, pool);
+  std::vector<std::uint32_t> order(count);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, count);
+    for (std::size_t i = block * kBlockSize; i < end; i++)
+      order[i] = static_cast<std::uint32_t>(keys[i] & 0xFFFFFFFFu);
+  });
+  return order;
+}
+
+bool indexInRange(int index, std::size_t vertexCount) {
+  return index >= 0 && static_cast<std::size_t>(index) < vertexCount;
+}
+
+/**
+ * @brief Проверяет, что все индексы треугольников ссылаются на вершины.
+ */
+bool trianglesInRange(const std::vector<int> &triangles,
+                      std::size_t vertexCount, ThreadPool &pool) {
+  std::size_t indexes = triangles.size() / 3 * 3;
+  std::size_t blocks = (indexes + kBlockSize - 1) / kBlockSize;
+  std::atomic<bool> valid{true};
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, indexes);
+    for (std::size_t i = block * kBlockSize; i < end; i++) {
+      if (!indexInRange(triangles[i], vertexCount)) {
+        valid.store(false, std::memory_order_relaxed);
+        return;
+      }
+    }
+  });
+  return valid.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Оставляет треугольники, все индексы которых ссылаются на
+ * вершины.
+ */
+std::vector<int> validTriangles(const std::vector<int> &triangles,
+                                std::size_t vertexCount) {
+  std::vector<int> valid{};
+  valid.reserve(triangles.size());
+  for (std::size_t t = 0; t + 3 <= triangles.size(); t += 3) {
+    if (indexInRange(triangles[t], vertexCount) &&
+        indexInRange(triangles[t + 1], vertexCount) &&
+        indexInRange(triangles[t + 2], vertexCount))
+      valid.insert(valid.end(), &triangles[t], &triangles[t] + 3);
+  }
+  return valid;
+}
+
+/**
+ * @brief Удаляет вершины, на которые не ссылаются треугольники, и
+ * перенумеровывает треугольники и рёбра.
+ */
+void compact(std::vector<float> &positions,
+             const std::vector<unsigned char> &used, MeshLod &lod,
+             ThreadPool &pool) {
+  std::size_t count = used.size();
+  std::size_t blocks = (count + kBlockSize - 1) / kBlockSize;
+  std::vector<std::size_t> offsets(blocks + 1);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, count);
+    for (std::size_t v = block * kBlockSize; v < end; v++)
+      offsets[block + 1] += used[v];
+  });
+  for (std::size_t block = 0; block < blocks; block++)
+    offsets[block + 1] += offsets[block];
+
+  std::vector<int> remap(count, -1);
+  lod.vertexes.resize(offsets.back() * 3);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, count);
+    std::size_t next = offsets[block];
+    for (std::size_t v = block * kBlockSize; v < end; v++) {
+      if (!used[v]) continue;
+      remap[v] = static_cast<int>(next);
+      std::copy(&positions[v * 3], &positions[v * 3] + 3,
+                &lod.vertexes[next * 3]);
+      next++;
+    }
+  });
+  std::vector<float>().swap(positions);
+
+  std::size_t indexes = lod.triangles.size();
+  std::size_t indexBlocks = (indexes + kBlockSize - 1) / kBlockSize;
+  pool.run(indexBlocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, indexes);
+    for (std::size_t i = block * kBlockSize; i < end; i++)
+      lod.triangles[i] = remap[lod.triangles[i]];
+  });
+
+  std::vector<int> outlines(indexes / 3 * 4);
+  pool.run(indexBlocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, indexes) / 3;
+    for (std::size_t t = block * kBlockSize / 3; t < end; t++) {
+      std::copy(&lod.triangles[t * 3], &lod.triangles[t * 3] + 3,
+                &outlines[t * 4]);
+      outlines[t * 4 + 3] = -1;
+    }
+  });
+  lod.lines = EdgeExtractor::extract(outlines, pool);
+}
+}  // namespace
+
+std::vector<float> MeshSimplifier::defaultRatios() {
+  return {0.5f, 0.25f, 0.1f, 0.01f};
+}
+
+MeshLod MeshSimplifier::simplify(const std::vector<float> &vertexes,
+                                 const std::vector<int> &triangles,
+                                 std::size_t target, ThreadPool &pool,
+                                 const LoadProgress *progress) {
+  std::size_t vertexCount = vertexes.size() / 3;
+  // Треугольники со ссылками за пределы вершин (грань файла ссылается
+  // на несуществующую вершину) отбрасываются до любого обращения по их
+  // индексам; для корректной сетки копия не создаётся.
+  std::vector<int> filtered{};
+  bool inRange = trianglesInRange(triangles, vertexCount, pool);
+  if (!inRange) filtered = validTriangles(triangles, vertexCount);
+  const std::vector<int> &input = inRange ? triangles : filtered;
+  std::size_t count = input.size() / 3;
+  std::size_t parts = std::clamp<std::size_t>(
+      (count + kPartitionTriangles - 1) / kPartitionTriangles, 1,
+      kMaxPartitions);
+  std::vector<std::uint32_t> order{};
+  std::unique_ptr<std::atomic<int>[]> owners{};
+  if (parts > 1) {
+    order = mortonOrder(vertexes, input, pool);
+    owners = std::make_unique<std::atomic<int>[]>(vertexCount);
+    std::size_t blocks = (vertexCount + kBlockSize - 1) / kBlockSize;
+    pool.run(blocks, [&](std::size_t block) {
+      std::size_t end = std::min((block + 1) * kBlockSize, vertexCount);
+      for (std::size_t v = block * kBlockSize; v < end; v++)
+        owners[v].store(kUnowned, std::memory_order_relaxed);
+    });
+    // Вершина принадлежит участку, если все её треугольники в нём;
+    // итог не зависит от порядка, в котором участки её отмечают.
+    pool.run(parts, [&](std::size_t part) {
+      int id = static_cast<int>(part);
+      for (std::size_t i = part * count / parts;
+           i < (part + 1) * count / parts; i++) {
+        for (int corner = 0; corner < 3; corner++) {
+          std::atomic<int> &owner = owners[input[order[i] * 3 + corner]];
+          int expected = kUnowned;
+          if (!owner.compare_exchange_strong(expected, id,
+                                             std::memory_order_relaxed) &&
+              expected != id)
+            owner.store(kShared, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+
+  MeshLod lod{};
+  std::vector<float> positions = vertexes;
+  std::vector<unsigned char> used(vertexCount);
+  std::vector<std::vector<int>> parted(parts);
+  std::vector<double> costs(parts);
+  pool.run(parts, [&](std::size_t part) {
+    std::size_t first = part * count / parts;
+    std::size_t last = (part + 1) * count / parts;
+    std::vector<int> corners{};
+    corners.reserve((last - first) * 3);
+    for (std::size_t i = first; i < last; i++) {
+      const int *tri = &input[(order.empty() ? i : order[i]) * 3];
+      corners.insert(corners.end(), tri, tri + 3);
+    }
+    Partition partition(vertexes, std::move(corners), owners.get(),
+                        static_cast<int>(part));
+    // Цель делится между участками пропорционально их размеру.
+    partition.simplify(target * (last - first) / std::max<std::size_t>(
+                                                     count, 1),
+                       progress);
+    partition.emit(positions, used, parted[part]);
+    costs[part] = partition.maxCost();
+  });
+  if (owners) {
+    for (std::size_t v = 0; v < vertexCount; v++)
+      used[v] |= owners[v].load(std::memory_order_relaxed) == kShared;
+  }
+
+  std::size_t total = 0;
+  for (const std::vector<int> &part : parted) total += part.size();
+  lod.triangles.reserve(total);
+  for (std::vector<int> &part : parted) {
+    lod.triangles.insert(lod.triangles.end(), part.begin(), part.end());
+    std::vector<int>().swap(part);
+  }
+  lod.error = static_cast<float>(
+      std::sqrt(*std::max_element(costs.begin(), costs.end())));
+  compact(positions, used, lod, pool);
+  return lod;
+}
+
+std::vector<MeshLod> MeshSimplifier::buildChain(
+    const std::vector<float> &vertexes, const std::vector<int> &triangles,
+    const std::vector<float> &ratios, ThreadPool &pool,
+    LoadProgress *progress) {
+  std::size_t count = triangles.size() / 3;
+  if (progress != nullptr) progress->setTotal(count * ratios.size());
+  std::vector<MeshLod> chain{};
+  // Уровни ссылаются на предыдущие, поэтому вектор не должен
+  // перевыделяться.
+  chain.reserve(ratios.size());
+  const std::vector<float> *source = &vertexes;
+  const std::vector<int> *sourceTriangles = &triangles;
+  float error = 0.0f;
+  for (float ratio : ratios) {
+    if (progress != nullptr) progress->throwIfCancelled();
+    auto target = static_cast<std::size_t>(static_cast<double>(ratio) * count);
+    chain.push_back(
+        simplify(*source, *sourceTriangles, target, pool, progress));
+    MeshLod &lod = chain.back();
+    lod.ratio = ratio;
+    // Отклонения уровней складываются: каждый упрощён из предыдущего.
+    error += lod.error;
+    lod.error = error;
+    source = &lod.vertexes;
+    sourceTriangles = &lod.triangles;
+    if (progress != nullptr) progress->advance(count);
+  }
+  return chain;
+}
+}  // namespace s21
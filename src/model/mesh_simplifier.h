@@ -0,0 +1,92 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_MESH_SIMPLIFIER_H_
+#define VIEWER_FRONT_SRC_MODEL_MESH_SIMPLIFIER_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+class LoadProgress;
+class ThreadPool;
+
+/**
+ * @brief Уровень детализации сетки.
+ *
+ * Вершины уровня сжаты: в массив попадают только вершины, на которые
+ * ссылаются оставшиеся треугольники.
+ */
+struct MeshLod {
+  float ratio{};  ///< Запрошенная доля треугольников исходной сетки.
+  float error{};  ///< Оценка отклонения от исходной поверхности.
+  std::vector<float> vertexes;  ///< Вершины уровня, по три координаты.
+  std::vector<int> triangles;   ///< Треугольники, по три индекса.
+  std::vector<int> lines;       ///< Уникальные рёбра, пары индексов.
+};
+
+/**
+ * @brief Упрощение треугольной сетки схлопыванием рёбер по квадрикам
+ * ошибки (Garland-Heckbert).
+ *
+ * Каждой вершине сопоставляется сумма квадрик плоскостей её треугольников
+ * (на открытых краях - ещё и плоскостей, перпендикулярных краю), рёбра
+ * схлопываются в порядке возрастания ошибки в точку её минимума, а
+ * схлопывания, переворачивающие треугольники, отклоняются.
+ *
+ * Треугольники делятся по порядку Мортона их центров на пространственные
+ * участки, которые упрощаются параллельно и независимо. Вершины, общие
+ * для нескольких участков, закреплены: к ним можно стянуть соседку, но
+ * сами они не сдвигаются, поэтому швы между участками остаются целыми.
+ * Результат не зависит от числа потоков.
+ */
+class MeshSimplifier {
+ public:
+  /**
+   * @brief Доли треугольников цепочки уровней по умолчанию.
+   *
+   * @return std::vector<float> 50%, 25%, 10% и 1%.
+   */
+  static std::vector<float> defaultRatios();
+
+  /**
+   * @brief Упрощает сетку до заданного числа треугольников.
+   *
+   * Если закреплённые швы участков или перевороты не дают дойти до цели,
+   * треугольников остаётся больше.
+   *
+   * @param vertexes Координаты вершин, по три на вершину.
+   * @param triangles Треугольники, по три индекса.
+   * @param target Желаемое количество треугольников.
+   * @param pool Пул потоков.
+   * @param progress Отмена упрощения; nullptr - без отмены.
+   * @return MeshLod Упрощённая сетка; ratio не заполняется.
+   * @throw LoadCancelled Если упрощение отменено.
+   */
+  static MeshLod simplify(const std::vector<float> &vertexes,
+                          const std::vector<int> &triangles,
+                          std::size_t target, ThreadPool &pool,
+                          const LoadProgress *progress = nullptr);
+
+  /**
+   * @brief Строит цепочку уровней детализации.
+   *
+   * Каждый уровень упрощается из предыдущего, поэтому грубые уровни
+   * строятся по уже уменьшенной сетке, а швы участков на разных уровнях
+   * проходят в разных местах. Ошибка уровня накапливается по цепочке.
+   *
+   * @param vertexes Координаты вершин, по три на вершину.
+   * @param triangles Треугольники исходной сетки, по три индекса.
+   * @param ratios Доли треугольников по убыванию.
+   * @param pool Пул потоков.
+   * @param progress Прогресс (в треугольниках входа уровней) и отмена;
+   * nullptr - не отслеживаются.
+   * @return std::vector<MeshLod> Уровни в порядке ratios.
+   * @throw LoadCancelled Если построение отменено.
+   */
+  static std::vector<MeshLod> buildChain(const std::vector<float> &vertexes,
+                                         const std::vector<int> &triangles,
+                                         const std::vector<float> &ratios,
+                                         ThreadPool &pool,
+                                         LoadProgress *progress = nullptr);
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_MESH_SIMPLIFIER_H_
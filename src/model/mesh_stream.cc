@@ -0,0 +1,58 @@
+#include "mesh_stream.h"
+
+#include <utility>
+
+namespace s21 {
+MeshStream::MeshStream()
+    : mutex_{}, queues_{}, finished_{}, head_{}, bytes_{} {}
+
+void MeshStream::begin(std::size_t chunks, std::size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  queues_.assign(chunks, std::deque<MeshBatch>());
+  finished_.assign(chunks, false);
+  head_ = 0;
+  bytes_ = bytes;
+}
+
+void MeshStream::addChunks(std::size_t count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  queues_.resize(queues_.size() + count);
+  finished_.resize(finished_.size() + count, false);
+}
+
+void MeshStream::publish(std::size_t chunk, MeshBatch batch) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  queues_[chunk].push_back(std::move(batch));
+}
+
+void MeshStream::finishChunk(std::size_t chunk) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  finished_[chunk] = true;
+}
+
+std::vector<MeshBatch> MeshStream::take() {
+  std::vector<MeshBatch> batches{};
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (head_ < queues_.size()) {
+    std::deque<MeshBatch> &queue = queues_[head_];
+    for (MeshBatch &batch : queue) batches.push_back(std::move(batch));
+    queue.clear();
+    if (!finished_[head_]) break;
+    head_++;
+  }
+  return batches;
+}
+
+// Оценки совпадают с резервированием памяти в Model: строка вершины
+// занимает около 32 байт и вершины составляют около половины файла, на
+// индекс грани приходится около 16 байт.
+std::size_t MeshStream::expectedVertexes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_ / 64;
+}
+
+std::size_t MeshStream::expectedIndexes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_ / 16;
+}
+}  // namespace s21
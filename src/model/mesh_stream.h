@@ -0,0 +1,110 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_MESH_STREAM_H_
+#define VIEWER_FRONT_SRC_MODEL_MESH_STREAM_H_
+
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace s21 {
+/**
+ * @brief Порция вершин и индексов, опубликованная разборщиком.
+ *
+ * Вершины порции идут в модели сразу за вершинами предыдущей порции,
+ * контуры граней содержат абсолютные индексы (с нуля) и разделители, как
+ * в Model::getOutlines(); каждая грань целиком входит в одну порцию.
+ */
+struct MeshBatch {
+  std::vector<float> vertexes;  ///< Координаты вершин порции.
+  std::vector<int> outlines;    ///< Контуры граней порции.
+  float min[3]{HUGE_VALF, HUGE_VALF, HUGE_VALF};  ///< Минимумы вершин порции.
+  float max[3]{-HUGE_VALF, -HUGE_VALF,
+               -HUGE_VALF};  ///< Максимумы вершин порции.
+};
+
+/**
+ * @brief Очередь порций модели от разборщика к отображению.
+ *
+ * Участки файла разбираются параллельно, и каждый публикует порции
+ * фиксированного размера по мере разбора. Потребитель получает порции
+ * строго в порядке следования в файле: порции участка выдаются только
+ * после того, как выданы все порции предыдущих участков, поэтому вершины
+ * можно дописывать в конец буфера без пересчёта смещений.
+ */
+class MeshStream {
+ public:
+  /// Количество вершин в полной порции.
+  static constexpr std::size_t kBatchVertexes = std::size_t{1} << 16;
+  /// Количество индексов граней в полной порции.
+  static constexpr std::size_t kBatchIndexes = std::size_t{1} << 18;
+
+  MeshStream();
+
+  /**
+   * @brief Начинает новую загрузку, отбрасывая невыданные порции.
+   *
+   * @param chunks Количество участков, на которые разбит файл.
+   * @param bytes Размер файла; 0, если неизвестен.
+   */
+  void begin(std::size_t chunks, std::size_t bytes);
+
+  /**
+   * @brief Добавляет участки в конец загрузки.
+   *
+   * Нужен, когда количество участков заранее неизвестно, например при
+   * распаковке сжатого файла.
+   *
+   * @param count Количество новых участков.
+   */
+  void addChunks(std::size_t count);
+
+  /**
+   * @brief Публикует порцию участка.
+   *
+   * @param chunk Номер участка в порядке следования в файле.
+   * @param batch Порция.
+   */
+  void publish(std::size_t chunk, MeshBatch batch);
+
+  /**
+   * @brief Отмечает, что участок больше не опубликует порций.
+   *
+   * @param chunk Номер участка.
+   */
+  void finishChunk(std::size_t chunk);
+
+  /**
+   * @brief Забирает порции, готовые к выдаче.
+   *
+   * @return std::vector<MeshBatch> Порции в порядке следования в файле;
+   * пустой вектор, если новых порций нет.
+   */
+  std::vector<MeshBatch> take();
+
+  /**
+   * @brief Оценивает количество вершин модели по размеру файла.
+   *
+   * @return std::size_t Ожидаемое количество вершин; 0, если размер
+   * файла неизвестен.
+   */
+  [[nodiscard]] std::size_t expectedVertexes() const;
+
+  /**
+   * @brief Оценивает количество индексов граней по размеру файла.
+   *
+   * @return std::size_t Ожидаемое количество индексов; 0, если размер
+   * файла неизвестен.
+   */
+  [[nodiscard]] std::size_t expectedIndexes() const;
+
+ private:
+  mutable std::mutex mutex_;                   ///< Защита очереди.
+  std::vector<std::deque<MeshBatch>> queues_;  ///< Порции по участкам.
+  std::vector<bool> finished_;                 ///< Завершённые участки.
+  std::size_t head_;   ///< Первый участок с невыданными порциями.
+  std::size_t bytes_;  ///< Размер файла.
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_MESH_STREAM_H_
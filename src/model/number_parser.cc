@@ -0,0 +1,90 @@
+#include "number_parser.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace s21 {
+namespace {
+constexpr double kPowersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+constexpr int kMaxExactPower = 22;
+constexpr int kMaxMantissaDigits = 19;
+
+bool isDigit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+}  // namespace
+
+bool NumberParser::parseFloat(const char *&cursor, const char *end,
+                              float &value) {
+  const char *p = cursor;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+
+  std::uint64_t mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool hasDigits = false;
+  for (; p < end && isDigit(*p); p++, hasDigits = true) {
+    if (digits < kMaxMantissaDigits) {
+      mantissa = mantissa * 10 + (*p - '0');
+      digits += mantissa != 0;
+    } else {
+      exponent++;
+    }
+  }
+  if (p < end && *p == '.') {
+    for (p++; p < end && isDigit(*p); p++, hasDigits = true) {
+      if (digits < kMaxMantissaDigits) {
+        mantissa = mantissa * 10 + (*p - '0');
+        digits += mantissa != 0;
+        exponent--;
+      }
+    }
+  }
+  if (!hasDigits) return false;
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    const char *e = p + 1;
+    bool negativeExp = false;
+    if (e < end && (*e == '-' || *e == '+')) negativeExp = *e++ == '-';
+    if (e < end && isDigit(*e)) {
+      int exp = 0;
+      for (; e < end && isDigit(*e); e++) {
+        if (exp < 10000) exp = exp * 10 + (*e - '0');
+      }
+      exponent += negativeExp ? -exp : exp;
+      p = e;
+    }
+  }
+
+  double result = static_cast<double>(mantissa);
+  if (mantissa != 0) {
+    if (exponent < 0 && exponent >= -kMaxExactPower) {
+      result /= kPowersOfTen[-exponent];
+    } else if (exponent > 0 && exponent <= kMaxExactPower) {
+      result *= kPowersOfTen[exponent];
+    } else if (exponent != 0) {
+      result *= std::pow(10.0, exponent);
+    }
+  }
+  value = static_cast<float>(negative ? -result : result);
+  cursor = p;
+  return true;
+}
+
+bool NumberParser::parseInt(const char *&cursor, const char *end, int &value) {
+  const char *p = cursor;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+  if (p == end || !isDigit(*p)) return false;
+
+  long long result = 0;
+  for (; p < end && isDigit(*p); p++) {
+    if (result <= INT32_MAX) result = result * 10 + (*p - '0');
+  }
+  if (result > INT32_MAX) result = INT32_MAX;
+  value = static_cast<int>(negative ? -result : result);
+  cursor = p;
+  return true;
+}
+}  // namespace s21
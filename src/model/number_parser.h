@@ -0,0 +1,42 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_NUMBER_PARSER_H_
+#define VIEWER_FRONT_SRC_MODEL_NUMBER_PARSER_H_
+
+namespace s21 {
+/**
+ * @brief Разбор чисел из текста OBJ-файла без выделения памяти.
+ *
+ * В отличие от std::stof/std::stoi не требует std::string и не зависит от
+ * текущей локали: десятичным разделителем всегда считается точка.
+ */
+class NumberParser {
+ public:
+  /**
+   * @brief Читает число с плавающей точкой.
+   *
+   * Поддерживаются знак, дробная часть и экспонента (1.5, -2, .5e-3).
+   * Значения до 15 значащих цифр с порядком не больше 22 переводятся
+   * через точное значение double, остальные - с погрешностью порядка
+   * одного ulp.
+   *
+   * @param cursor Начало числа; после успешного чтения указывает на первый
+   * символ за числом.
+   * @param end Конец буфера.
+   * @param value Прочитанное значение.
+   * @return bool true, если число прочитано.
+   */
+  static bool parseFloat(const char *&cursor, const char *end, float &value);
+
+  /**
+   * @brief Читает целое число со знаком.
+   *
+   * @param cursor Начало числа; после успешного чтения указывает на первый
+   * символ за числом.
+   * @param end Конец буфера.
+   * @param value Прочитанное значение.
+   * @return bool true, если число прочитано.
+   */
+  static bool parseInt(const char *&cursor, const char *end, int &value);
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_NUMBER_PARSER_H_
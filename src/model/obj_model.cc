@@ -1,5 +1,65 @@
 #include "obj_model.h"
+
+#include <algorithm>
+
+#include "char_scanner.h"
+#include "decompressor.h"
+#include "edge_extractor.h"
+#include "mapped_file.h"
+#include "mesh_cache.h"
+#include "number_parser.h"
+#include "thread_pool.h"
+#include "triangulator.h"
+
 namespace s21 {
+namespace {
+/// Размер участка, разбираемого одной задачей.
+constexpr std::size_t kChunkSize = std::size_t{4} << 20;
+/// Шаг, с которым разбор отмечает прогресс и проверяет отмену.
+constexpr std::size_t kProgressStep = std::size_t{256} << 10;
+
+/**
+ * @brief Публикует ещё не опубликованную часть участка одной порцией.
+ *
+ * @param chunk Участок.
+ * @param vertexes Количество уже опубликованных координат; обновляется.
+ * @param outlines Количество уже опубликованных индексов контуров;
+ * обновляется.
+ * @param stream Очередь порций.
+ * @param index Номер участка.
+ */
+void publishBatch(const MeshChunk &chunk, std::size_t &vertexes,
+                  std::size_t &outlines, MeshStream &stream,
+                  std::size_t index) {
+  if (vertexes == chunk.vertexes.size() && outlines == chunk.outlines.size())
+    return;
+  MeshBatch batch{};
+  batch.vertexes.assign(chunk.vertexes.begin() + vertexes,
+                        chunk.vertexes.end());
+  batch.outlines.assign(chunk.outlines.begin() + outlines,
+                        chunk.outlines.end());
+  BoundingBox box =
+      BoundingBox::compute(batch.vertexes.data(), batch.vertexes.size() / 3);
+  std::copy(box.min, box.min + 3, batch.min);
+  std::copy(box.max, box.max + 3, batch.max);
+  vertexes = chunk.vertexes.size();
+  outlines = chunk.outlines.size();
+  stream.publish(index, std::move(batch));
+}
+
+/**
+ * @brief Публикует порцию, если набралось не меньше порции вершин или
+ * индексов.
+ */
+void publishFullBatch(const MeshChunk &chunk, std::size_t &vertexes,
+                      std::size_t &outlines, MeshStream &stream,
+                      std::size_t index) {
+  if (chunk.vertexes.size() - vertexes >= MeshStream::kBatchVertexes * 3 ||
+      chunk.outlines.size() - outlines >= MeshStream::kBatchIndexes)
+    publishBatch(chunk, vertexes, outlines, stream, index);
+}
+}  // namespace
+
 Model::Model()
     : minX_{},
       maxX_{},
@@ -10,13 +70,18 @@ Model::Model()
       centerX_{},
       centerY_{},
       centerZ_{},
+      radius_{},
+      weldStats_{},
       filename_{},
+      options_{},
       vertexes_{},
       edges_{},
+      outlines_{},
+      lines_{},
       vertexCount_{},
       facetsCount_{} {}
 
-Model::Model(std::string filename)
+Model::Model(std::string filename, ParseOptions options)
     : minX_{},
       maxX_{},
       minY_{},
@@ -26,144 +91,378 @@ Model::Model(std::string filename)
       centerX_{},
       centerY_{},
       centerZ_{},
+      radius_{},
+      weldStats_{},
       filename_{std::move(filename)},
+      options_{options},
       vertexes_{},
       edges_{},
+      outlines_{},
+      lines_{},
       vertexCount_{},
       facetsCount_{} {
   parseFile();
+  // Прогресс и очередь порций принадлежат вызывающему и нужны только на
+  // время разбора.
+  options_.progress = nullptr;
+  options_.stream = nullptr;
+}
+
+Model Model::fromText(std::string_view text, ParseOptions options) {
+  Model model{};
+  model.options_ = options;
+  model.options_.useCache = false;
+  model.parseBuffer(text);
+  model.finishParse();
+  if (options.progress != nullptr) options.progress->finish();
+  model.options_.progress = nullptr;
+  model.options_.stream = nullptr;
+  return model;
 }
 
 Model::~Model() = default;
 
 bool Model::checkFilename() {
-  const std::string extension = ".obj";
-
-  return filename_.size() >= extension.size() &&
-         filename_.compare(filename_.size() - extension.size(),
-                           extension.size(), extension) == 0;
+  for (const std::string extension : {".obj", ".obj.gz", ".obj.zst"}) {
+    if (filename_.size() >= extension.size() &&
+        filename_.compare(filename_.size() - extension.size(),
+                          extension.size(), extension) == 0)
+      return true;
+  }
+  return false;
 }
 
 int Model::fillInfo() {
   int result{};
 
-  std::fstream file(filename_);
-  if (file.is_open()) {
-    std::string line{};
-    int vCounter{};
-    facetsCount_ = 0;
-    while (std::getline(file, line)) {
-      if (line[0] == 'v' && line[1] == ' ') {
-        Model::extractVertexes(line, vCounter);
-        vCounter += 3;
-      }
-      if (line[0] == 'f' && line[1] == ' ') {
-        Model::extractFacets(line);
-      }
+  Decompressor::Format format = Decompressor::detect(filename_);
+  if (format != Decompressor::kNone) {
+    Decompressor source(filename_, format);
+    if (source.isOpen()) {
+      parseCompressed(source);
+    } else {
+      std::cerr << "Error opening file:" << filename_ << '\n';
+      result = 1;
     }
-    file.close();
+    return result;
+  }
+  MappedFile mapped(filename_);
+  if (mapped.isOpen()) {
+    parseBuffer(mapped.view());
   } else {
-    result = 1;
+    std::ifstream file(filename_, std::ios::binary);
+    if (file.is_open()) {
+      parseStream(file);
+    } else {
+      std::cerr << "Error opening file:" << filename_ << '\n';
+      result = 1;
+    }
   }
   return result;
 }
 
-int Model::extractVertexes(const std::string &line, int step) {
-  std::stringstream ss(line.substr(2));
-  std::string tmp;
-  int code = 0;
+void Model::parseBuffer(std::string_view buffer) {
+  if (options_.progress != nullptr) {
+    options_.progress->setTotal(buffer.size());
+    options_.progress->throwIfCancelled();
+  }
+  std::vector<std::string_view> texts{};
+  std::size_t begin = 0;
+  while (begin < buffer.size()) {
+    std::size_t end = buffer.size();
+    if (end - begin > kChunkSize) {
+      end = buffer.find('\n', begin + kChunkSize);
+      end = end == std::string_view::npos ? buffer.size() : end + 1;
+    }
+    texts.push_back(buffer.substr(begin, end - begin));
+    begin = end;
+  }
 
-  while (ss >> tmp) {
-    float value = std::stof(tmp);
-    switch (code) {
-      case 0:
-        vertexes_[step] = value;
-        updateMinMax(value, minX_, maxX_);
-        break;
-      case 1:
-        vertexes_[step + 1] = value;
-        updateMinMax(value, minY_, maxY_);
-        break;
-      case 2:
-        vertexes_[step + 2] = value;
-        updateMinMax(value, minZ_, maxZ_);
-        break;
+  std::unique_ptr<ThreadPool> ownPool{};
+  if (options_.threads != 0 && texts.size() > 1)
+    ownPool = std::make_unique<ThreadPool>(options_.threads);
+  ThreadPool &pool = ownPool ? *ownPool : ThreadPool::shared();
+
+  if (options_.stream != nullptr)
+    options_.stream->begin(texts.size(), buffer.size());
+  std::vector<MeshChunk> chunks(texts.size());
+  pool.run(texts.size(), [&](std::size_t i) {
+    reserveFor(texts[i].size(), chunks[i]);
+    parseText(texts[i], chunks[i], options_, i);
+  });
+  mergeChunks(chunks, pool);
+}
+
+void Model::parseStream(std::istream &stream) {
+  std::vector<MeshChunk> chunks(1);
+  std::string line{};
+  CharScanner scanner{};
+  std::size_t publishedVertexes{}, publishedOutlines{};
+  if (options_.stream != nullptr) options_.stream->begin(1, 0);
+  for (std::size_t lines = 1; std::getline(stream, line); lines++) {
+    scanner.reset(line.data(), line.data() + line.size());
+    parseLine(line, chunks[0], scanner);
+    if (options_.progress != nullptr) {
+      options_.progress->advance(line.size() + 1);
+      if (lines % 4096 == 0) options_.progress->throwIfCancelled();
     }
-    code++;
+    if (options_.stream != nullptr)
+      publishFullBatch(chunks[0], publishedVertexes, publishedOutlines,
+                       *options_.stream, 0);
   }
-  return (code == 3) ? 0 : 1;
+  if (options_.stream != nullptr) {
+    publishBatch(chunks[0], publishedVertexes, publishedOutlines,
+                 *options_.stream, 0);
+    options_.stream->finishChunk(0);
+  }
+  chunks[0].bounds = BoundingBox::compute(chunks[0].vertexes.data(),
+                                          chunks[0].vertexes.size() / 3);
+  mergeChunks(chunks, ThreadPool::shared());
 }
 
-int Model::extractFacets(const std::string &line) {
-  int result{};
-  std::vector<int> tmpDigits{};
-  int tmpCount{};
-
-  for (size_t i = 0; i < line.size(); i++) {
-    if (std::isdigit(line[i]) && line[i - 1] == ' ') {
-      std::string digit{};
-      while (line[i] != '/') {
-        digit.push_back(line[i]);
-        if (i + 1 == line.size())
-          break;
-        else
-          i++;
+void Model::parseCompressed(Decompressor &source) {
+  LoadProgress *progress = options_.progress;
+  if (progress != nullptr) {
+    progress->setTotal(source.compressedSize());
+    progress->throwIfCancelled();
+  }
+  std::unique_ptr<ThreadPool> ownPool{};
+  if (options_.threads != 0)
+    ownPool = std::make_unique<ThreadPool>(options_.threads);
+  ThreadPool &pool = ownPool ? *ownPool : ThreadPool::shared();
+  if (options_.stream != nullptr)
+    options_.stream->begin(0, source.expectedSize());
+
+  // Прогресс отмечается по сжатым байтам между партиями блоков.
+  ParseOptions chunkOptions = options_;
+  chunkOptions.progress = nullptr;
+  std::vector<MeshChunk> chunks{};
+  std::vector<std::string> texts{};
+  std::string block{}, carry{};
+  std::size_t reported = 0;
+  for (bool more = true; more;) {
+    // Первого блока партии приходится ждать, остальные берутся, только
+    // если уже распакованы, чтобы не простаивать в ожидании распаковки.
+    texts.clear();
+    while (texts.size() < pool.size() && (texts.empty() || source.ready())) {
+      if (!source.next(block)) {
+        more = false;
+        break;
+      }
+      std::size_t cut = block.rfind('\n');
+      if (cut == std::string::npos) {
+        carry += block;
+        continue;
       }
-      tmpDigits.push_back(std::stoi(digit));
-      tmpCount++;
+      carry.append(block, 0, cut + 1);
+      texts.push_back(std::move(carry));
+      carry.assign(block, cut + 1, std::string::npos);
+    }
+    if (!more && !carry.empty()) texts.push_back(std::move(carry));
+
+    std::size_t first = chunks.size();
+    chunks.resize(first + texts.size());
+    if (options_.stream != nullptr) options_.stream->addChunks(texts.size());
+    pool.run(texts.size(), [&](std::size_t i) {
+      reserveFor(texts[i].size(), chunks[first + i]);
+      parseText(texts[i], chunks[first + i], chunkOptions, first + i);
+    });
+    if (progress != nullptr) {
+      std::size_t consumed = source.consumedBytes();
+      progress->advance(consumed - reported);
+      reported = consumed;
+      progress->throwIfCancelled();
     }
   }
-  this->edges_.resize(facetsCount_ + tmpCount);
-  for (int i = 0; i < tmpCount; i++) {
-    this->edges_[i + facetsCount_] = tmpDigits[i] - 1;
+  mergeChunks(chunks, pool);
+}
+
+void Model::mergeChunks(std::vector<MeshChunk> &chunks, ThreadPool &pool) {
+  std::vector<std::size_t> vertexOffsets(chunks.size() + 1);
+  std::vector<std::size_t> edgeOffsets(chunks.size() + 1);
+  BoundingBox box{};
+  for (std::size_t i = 0; i < chunks.size(); i++) {
+    vertexOffsets[i + 1] = vertexOffsets[i] + chunks[i].vertexes.size();
+    edgeOffsets[i + 1] = edgeOffsets[i] + chunks[i].outlines.size();
+    vertexCount_ += chunks[i].vertexCount;
+    facetsCount_ += chunks[i].faceCount;
+    box.merge(chunks[i].bounds);
+  }
+  // Модель без вершин сохраняет нулевые границы.
+  if (!box.empty()) {
+    minX_ = box.min[0], maxX_ = box.max[0];
+    minY_ = box.min[1], maxY_ = box.max[1];
+    minZ_ = box.min[2], maxZ_ = box.max[2];
   }
-  facetsCount_ += tmpCount;
 
-  return result;
+  if (chunks.size() == 1) {
+    vertexes_ = std::move(chunks[0].vertexes);
+    outlines_ = std::move(chunks[0].outlines);
+    return;
+  }
+  vertexes_.resize(vertexOffsets.back());
+  outlines_.resize(edgeOffsets.back());
+  pool.run(chunks.size(), [&](std::size_t i) {
+    std::copy(chunks[i].vertexes.begin(), chunks[i].vertexes.end(),
+              vertexes_.begin() + vertexOffsets[i]);
+    std::copy(chunks[i].outlines.begin(), chunks[i].outlines.end(),
+              outlines_.begin() + edgeOffsets[i]);
+    chunks[i] = MeshChunk();
+  });
 }
 
-int Model::checkObjectFile() {
-  int result = 0;
-  if (Model::checkFilename()) {
-    std::ifstream file(filename_);
-
-    if (file.is_open()) {
-      std::string line{};
-      while (std::getline(file, line)) {
-        vertexCount_ += (line[0] == 'v' && line[1] == ' ');
-        facetsCount_ += (line[0] == 'f' && line[1] == ' ');
-      }
-      file.close();
-    } else {
-      std::cerr << "Error opening file:" << filename_ << '\n';
-      result = 1;
+void Model::parseText(std::string_view text, MeshChunk &chunk,
+                      const ParseOptions &options, std::size_t index) {
+  LoadProgress *progress = options.progress;
+  MeshStream *stream = options.stream;
+  const char *cursor = text.data();
+  const char *end = cursor + text.size();
+  const char *reported = cursor;
+  std::size_t publishedVertexes{}, publishedOutlines{};
+  CharScanner scanner(cursor, end);
+  while (cursor < end) {
+    const char *lineEnd = scanner.next(cursor, CharScanner::kNewline);
+    parseLine(std::string_view(cursor, lineEnd - cursor), chunk, scanner);
+    cursor = lineEnd + 1;
+    if (progress != nullptr &&
+        static_cast<std::size_t>(cursor - reported) >= kProgressStep) {
+      progress->advance(cursor - reported);
+      reported = cursor;
+      progress->throwIfCancelled();
     }
-  } else
-    result = 1;
+    if (stream != nullptr)
+      publishFullBatch(chunk, publishedVertexes, publishedOutlines, *stream,
+                       index);
+  }
+  if (progress != nullptr && reported < end) progress->advance(end - reported);
+  // Границы считаются, пока вершины участка ещё в кэше процессора.
+  chunk.bounds =
+      BoundingBox::compute(chunk.vertexes.data(), chunk.vertexes.size() / 3);
+  if (stream != nullptr) {
+    publishBatch(chunk, publishedVertexes, publishedOutlines, *stream, index);
+    stream->finishChunk(index);
+  }
+}
 
-  return result;
+void Model::parseLine(std::string_view line, MeshChunk &chunk,
+                      const CharScanner &scanner) {
+  if (line.size() < 2 || line[1] != ' ') return;
+  if (line[0] == 'v') {
+    Model::extractVertexes(line, chunk);
+    chunk.vertexCount++;
+  } else if (line[0] == 'f') {
+    Model::extractFacets(line, chunk, scanner);
+  }
 }
+
+void Model::reserveFor(std::size_t textSize, MeshChunk &chunk) {
+  // В типичном OBJ строка вершины занимает около 32 байт, а вершины - около
+  // половины файла; на один индекс грани в среднем приходится около 16 байт.
+  // Если оценка занижена, векторы дорастут геометрически.
+  chunk.vertexes.reserve(textSize / 64 * 3);
+  chunk.outlines.reserve(textSize / 16);
+}
+
+void Model::finishParse() {
+  std::unique_ptr<ThreadPool> ownPool{};
+  if (options_.threads != 0)
+    ownPool = std::make_unique<ThreadPool>(options_.threads);
+  ThreadPool &pool = ownPool ? *ownPool : ThreadPool::shared();
+  // Отмена проверяется между этапами: каждый из них на большой модели
+  // занимает секунды, а MainWindow ждёт завершения в потоке интерфейса.
+  LoadProgress *progress = options_.progress;
+  if (progress != nullptr) progress->throwIfCancelled();
+  weldVertexes(pool);
+  if (progress != nullptr) progress->throwIfCancelled();
+  centerX_ = (maxX_ + minX_) / 2.0f;
+  centerY_ = (maxY_ + minY_) / 2.0f;
+  centerZ_ = (maxZ_ + minZ_) / 2.0f;
+  const float center[3] = {centerX_, centerY_, centerZ_};
+  radius_ = BoundingBox::radius(vertexes_, center, pool);
+  buildFaces(pool);
+}
+
+void Model::weldVertexes(ThreadPool &pool) {
+  weldStats_ = VertexWelder::weld(vertexes_, outlines_,
+                                  options_.weldTolerance, pool);
+  if (weldStats_.vertexesAfter == weldStats_.vertexesBefore) return;
+  vertexCount_ = static_cast<unsigned int>(weldStats_.vertexesAfter);
+  BoundingBox box = BoundingBox::compute(vertexes_, pool);
+  minX_ = box.min[0], maxX_ = box.max[0];
+  minY_ = box.min[1], maxY_ = box.max[1];
+  minZ_ = box.min[2], maxZ_ = box.max[2];
+}
+
+void Model::buildFaces(ThreadPool &pool) {
+  if (options_.progress != nullptr) options_.progress->throwIfCancelled();
+  edges_ = Triangulator::triangulate(outlines_, vertexes_, pool);
+  if (options_.progress != nullptr) options_.progress->throwIfCancelled();
+  lines_ = EdgeExtractor::extract(outlines_, pool);
+}
+
+int Model::extractVertexes(std::string_view line, MeshChunk &chunk) {
+  const char *cursor = line.data() + 2;
+  const char *end = line.data() + line.size();
+  int code = 0;
+
+  while (code < 3) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t')) cursor++;
+    if (cursor == end || *cursor == '\r') break;
+    float value{};
+    if (!NumberParser::parseFloat(cursor, end, value))
+      throw std::invalid_argument("Error in file parse");
+    chunk.vertexes.push_back(value);
+    code++;
+  }
+  for (int i = code; i < 3; i++) chunk.vertexes.push_back(0.0f);
+  return (code == 3) ? 0 : 1;
+}
+
+int Model::extractFacets(std::string_view line, MeshChunk &chunk,
+                         const CharScanner &scanner) {
+  const char *cursor = line.data() + 1;
+  const char *end = line.data() + line.size();
+  std::size_t first = chunk.outlines.size();
+
+  // Берётся индекс вершины каждой группы "v/vt/vn", стоящей после
+  // пробела; индексы текстуры и нормали за '/' пропускаются поиском
+  // следующего пробела.
+  while ((cursor = scanner.next(cursor, CharScanner::kSpace, end)) < end) {
+    cursor++;
+    int index{};
+    if (cursor < end && *cursor >= '0' && *cursor <= '9' &&
+        NumberParser::parseInt(cursor, end, index) && index > 0)
+      chunk.outlines.push_back(index - 1);
+  }
+  if (chunk.outlines.size() == first) return 1;
+  chunk.outlines.push_back(kPrimitiveRestart);
+  chunk.faceCount++;
+  return 0;
+}
+
 const std::vector<float> &Model::getVertexes() { return vertexes_; }
 const std::vector<int> &Model::getEdges() { return edges_; }
+const std::vector<int> &Model::getOutlines() { return outlines_; }
+const std::vector<int> &Model::getLines() { return lines_; }
 unsigned int Model::getVertexCount() const { return vertexCount_; }
 unsigned int Model::getFacetsCount() const { return facetsCount_; }
 void Model::parseFile() {
-  if (Model::checkObjectFile() == 0) {
-    vertexes_.resize(vertexCount_ * 3);
-    edges_.resize(facetsCount_ * 3);
-    if (Model::fillInfo() == 0) {
-      centerX_ = (maxX_ + minX_) / 2.0f;
-      centerY_ = (maxY_ + minY_) / 2.0f;
-      centerZ_ = (maxZ_ + minZ_) / 2.0f;
-    } else
-      throw std::invalid_argument("Error in file parse");
+  if (!Model::checkFilename())
+    throw std::invalid_argument("Error in file parse");
+  if (options_.useCache && MeshCache::load(filename_, *this)) {
+    if (options_.progress != nullptr) options_.progress->finish();
+    return;
+  }
+
+  if (Model::fillInfo() == 0) {
+    finishParse();
+    if (options_.progress != nullptr) options_.progress->throwIfCancelled();
+    if (options_.useCache)
+      MeshCache::save(filename_, *this, options_.progress);
+    if (options_.progress != nullptr) options_.progress->finish();
   } else
     throw std::invalid_argument("Error in file parse");
 }
-void Model::updateMinMax(float value, float &min, float &max) {
-  min = std::min(min, value);
-  max = std::max(max, value);
-}
 
 float Model::getMinX() const { return minX_; }
 float Model::getMaxX() const { return maxX_; }
@@ -171,4 +470,9 @@ float Model::getMinY() const { return minY_; }
 float Model::getMaxY() const { return maxY_; }
 float Model::getMinZ() const { return minZ_; }
 float Model::getMaxZ() const { return maxZ_; }
+float Model::getCenterX() const { return centerX_; }
+float Model::getCenterY() const { return centerY_; }
+float Model::getCenterZ() const { return centerZ_; }
+float Model::getRadius() const { return radius_; }
+const WeldStats &Model::getWeldStats() const { return weldStats_; }
 }  // namespace s21
\ No newline at end of file
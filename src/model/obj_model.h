@@ -8,10 +8,60 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "bounding_box.h"
+#include "load_progress.h"
+#include "mesh_stream.h"
+#include "vertex_welder.h"
+
 namespace s21 {
+class CharScanner;
+class Decompressor;
+class ThreadPool;
+
+/**
+ * @brief Параметры загрузки модели.
+ */
+struct ParseOptions {
+  /// Число потоков разбора; 0 - общий пул по числу аппаратных потоков.
+  unsigned int threads = 0;
+  /// Читать и записывать двоичный кэш разобранной модели (.objcache).
+  bool useCache = false;
+  /// Прогресс и отмена загрузки; nullptr - не отслеживаются.
+  LoadProgress *progress = nullptr;
+  /// Очередь порций для показа модели по ходу разбора; nullptr - порции
+  /// не публикуются.
+  MeshStream *stream = nullptr;
+  /// Допуск сварки вершин после разбора: отрицательный - сварка выключена,
+  /// 0 - сливаются только вершины с совпадающими координатами.
+  float weldTolerance = -1.0f;
+};
+
+/**
+ * @brief Индекс-разделитель многоугольников в контурах граней.
+ *
+ * При передаче индексов как GL_UNSIGNED_INT совпадает с 0xFFFFFFFF, то
+ * есть с индексом GL_PRIMITIVE_RESTART_FIXED_INDEX.
+ */
+constexpr int kPrimitiveRestart = -1;
+
+/**
+ * @brief Результат разбора непрерывного участка OBJ-файла.
+ *
+ * Каждый участок разбирается независимо, после чего участки склеиваются
+ * в модель в порядке следования в файле.
+ */
+struct MeshChunk {
+  std::vector<float> vertexes;  ///< Координаты вершин участка.
+  std::vector<int> outlines;  ///< Контуры граней через kPrimitiveRestart.
+  unsigned int vertexCount{};  ///< Количество вершин участка.
+  unsigned int faceCount{};    ///< Количество граней участка.
+  BoundingBox bounds;          ///< Границы вершин участка.
+};
+
 /**
  * @brief Класс для работы с 3D моделью.
  */
@@ -27,8 +77,30 @@ class Model {
    * @brief Конструктор, загружающий модель из файла.
    *
    * @param filename Путь к файлу, содержащему модель.
+   * @param options Параметры загрузки.
    */
-  explicit Model(std::string filename);
+  explicit Model(std::string filename, ParseOptions options = ParseOptions());
+
+  /**
+   * @brief Разбирает модель из текста OBJ, находящегося в памяти.
+   *
+   * Подходит для буферов, полученных без файловой системы: из архива,
+   * распаковщика или теста. Загрузка из файла отображает файл в память и
+   * разбирает его тем же путём.
+   *
+   * @param text Текст OBJ; должен оставаться доступным только на время
+   * вызова.
+   * @param options Параметры загрузки; кэш не используется.
+   * @return Model Разобранная модель.
+   * @throw std::invalid_argument Если текст содержит ошибку.
+   */
+  static Model fromText(std::string_view text,
+                        ParseOptions options = ParseOptions());
+
+  Model(const Model &) = default;
+  Model(Model &&) noexcept = default;
+  Model &operator=(const Model &) = default;
+  Model &operator=(Model &&) noexcept = default;
 
   /**
    * @brief Деструктор класса Model.
@@ -44,12 +116,36 @@ class Model {
   [[nodiscard]] const std::vector<float> &getVertexes();
 
   /**
-   * @brief Получает вектор рёбер модели.
+   * @brief Получает треугольники модели.
    *
-   * @return const std::vector<int>& Ссылка на вектор рёбер.
+   * Грани триангулируются при загрузке: выпуклые - веером, невыпуклые -
+   * отсечением ушей.
+   *
+   * @return const std::vector<int>& Индексы вершин, по три на треугольник.
    */
   [[nodiscard]] const std::vector<int> &getEdges();
 
+  /**
+   * @brief Получает контуры граней модели.
+   *
+   * Индексы вершин каждой грани идут в порядке обхода и завершаются
+   * kPrimitiveRestart, что позволяет рисовать границы граней через
+   * GL_LINE_LOOP с перезапуском примитива, без диагоналей триангуляции.
+   *
+   * @return const std::vector<int>& Контуры граней.
+   */
+  [[nodiscard]] const std::vector<int> &getOutlines();
+
+  /**
+   * @brief Получает уникальные неориентированные рёбра модели.
+   *
+   * Рёбра выделяются из контуров граней getOutlines() при загрузке;
+   * ребро, общее для соседних граней, входит один раз.
+   *
+   * @return const std::vector<int>& Пары индексов вершин для GL_LINES.
+   */
+  [[nodiscard]] const std::vector<int> &getLines();
+
   /**
    * @brief Получает количество вершин модели.
    *
@@ -106,6 +202,45 @@ class Model {
    */
   [[nodiscard]] float getMaxZ() const;
 
+  /**
+   * @brief Получает координату X центра ограничивающего параллелепипеда.
+   *
+   * @return float Координата X центра.
+   */
+  [[nodiscard]] float getCenterX() const;
+
+  /**
+   * @brief Получает координату Y центра ограничивающего параллелепипеда.
+   *
+   * @return float Координата Y центра.
+   */
+  [[nodiscard]] float getCenterY() const;
+
+  /**
+   * @brief Получает координату Z центра ограничивающего параллелепипеда.
+   *
+   * @return float Координата Z центра.
+   */
+  [[nodiscard]] float getCenterZ() const;
+
+  /**
+   * @brief Получает радиус ограничивающей сферы.
+   *
+   * Сфера построена вокруг центра параллелепипеда и содержит все вершины.
+   *
+   * @return float Радиус сферы.
+   */
+  [[nodiscard]] float getRadius() const;
+
+  /**
+   * @brief Получает итоги сварки вершин при загрузке.
+   *
+   * Если сварка выключена, количество вершин до и после совпадает.
+   *
+   * @return const WeldStats& Итоги сварки.
+   */
+  [[nodiscard]] const WeldStats &getWeldStats() const;
+
  private:
   /**
    * @brief Парсинг файла.
@@ -115,58 +250,154 @@ class Model {
   /**
    * @brief Заполняет информацию о модели.
    *
+   * Обычный файл отображается в память и разбирается без копирования
+   * строк; если отобразить файл нельзя (канал, устройство), он читается
+   * потоком. Файлы .obj.gz и .obj.zst распаковываются на лету.
+   *
    * @return int Статус выполнения операции.
    */
   int fillInfo();
 
+  /**
+   * @brief Разбирает содержимое OBJ-файла, находящееся в памяти.
+   *
+   * Буфер делится на участки по границам строк, участки разбираются
+   * параллельно и склеиваются в порядке следования в файле.
+   *
+   * @param buffer Текст файла.
+   */
+  void parseBuffer(std::string_view buffer);
+
+  /**
+   * @brief Разбирает OBJ-файл построчно из потока.
+   *
+   * @param stream Поток с текстом файла.
+   */
+  void parseStream(std::istream &stream);
+
+  /**
+   * @brief Разбирает сжатый OBJ-файл по мере распаковки.
+   *
+   * Распакованные блоки обрезаются по последнему переводу строки и
+   * разбираются параллельно, пока фоновый поток распаковывает следующие.
+   *
+   * @param source Распаковщик файла.
+   */
+  void parseCompressed(Decompressor &source);
+
+  /**
+   * @brief Склеивает разобранные участки в модель.
+   *
+   * Смещения участков находятся префиксной суммой, после чего участки
+   * копируются на свои места параллельно. Границы модели объединяются из
+   * границ участков.
+   *
+   * @param chunks Участки в порядке следования в файле.
+   * @param pool Пул потоков для копирования.
+   */
+  void mergeChunks(std::vector<MeshChunk> &chunks, ThreadPool &pool);
+
+  /**
+   * @brief Разбирает непрерывный набор строк OBJ-файла.
+   *
+   * По мере разбора в options.progress отмечаются обработанные байты и
+   * проверяется запрос отмены, а в options.stream публикуются порции
+   * разобранных вершин и граней.
+   *
+   * @param text Текст, начинающийся с начала строки.
+   * @param chunk Участок, в который добавляются вершины и грани.
+   * @param options Параметры загрузки.
+   * @param index Номер участка в порядке следования в файле.
+   */
+  static void parseText(std::string_view text, MeshChunk &chunk,
+                        const ParseOptions &options, std::size_t index);
+
+  /**
+   * @brief Разбирает одну строку OBJ-файла.
+   *
+   * @param line Строка без символа перевода строки.
+   * @param chunk Участок, в который добавляются вершины и грани.
+   * @param scanner Сканер разделителей текста, содержащего строку.
+   */
+  static void parseLine(std::string_view line, MeshChunk &chunk,
+                        const CharScanner &scanner);
+
   /**
    * @brief Извлекает грани из строки.
    *
    * @param line Строка, содержащая информацию о грани.
-   * @return int Статус выполнения операции.
+   * @param chunk Участок, в контуры которого добавляется грань.
+   * @param scanner Сканер разделителей текста, содержащего строку.
+   * @return int Статус выполнения операции; 1, если индексов в строке нет.
    */
-  int extractFacets(const std::string &line);
+  static int extractFacets(std::string_view line, MeshChunk &chunk,
+                           const CharScanner &scanner);
 
   /**
    * @brief Извлекает вершины из строки.
    *
    * @param line Строка, содержащая информацию о вершине.
-   * @param step Шаг для обработки.
+   * @param chunk Участок, в который добавляются координаты.
    * @return int Статус выполнения операции.
    */
-  int extractVertexes(const std::string &line, int step);
+  static int extractVertexes(std::string_view line, MeshChunk &chunk);
 
   /**
-   * @brief Проверяет файл объекта на корректность.
+   * @brief Резервирует память участка по размеру его текста.
    *
-   * @return int Статус выполнения операции.
+   * Позволяет обойтись одним проходом по файлу без предварительного
+   * подсчёта строк.
+   *
+   * @param textSize Размер текста участка в байтах.
+   * @param chunk Участок.
    */
-  int checkObjectFile();
+  static void reserveFor(std::size_t textSize, MeshChunk &chunk);
 
   /**
-   * @brief Проверяет имя файла на корректность.
+   * @brief Строит по контурам граней треугольники и уникальные рёбра.
    *
-   * @return bool true, если имя корректно; в противном случае false.
+   * @param pool Пул потоков.
    */
-  bool checkFilename();
+  void buildFaces(ThreadPool &pool);
 
   /**
-   * @brief Обновляет минимальные и максимальные значения.
+   * @brief Сваривает вершины с допуском options_.weldTolerance и
+   * перенумеровывает контуры граней.
    *
-   * @param value Значение для обновления.
-   * @param min Ссылка на минимальное значение.
-   * @param max Ссылка на максимальное значение.
+   * @param pool Пул потоков.
    */
-  void updateMinMax(float value, float &min, float &max);
+  void weldVertexes(ThreadPool &pool);
+
+  /**
+   * @brief Завершает разбор: сваривает вершины, находит центр и радиус
+   * модели и строит грани.
+   */
+  void finishParse();
+
+  /**
+   * @brief Проверяет имя файла на корректность.
+   *
+   * Допускаются расширения .obj, .obj.gz и .obj.zst.
+   *
+   * @return bool true, если имя корректно; в противном случае false.
+   */
+  bool checkFilename();
+
+  friend class MeshCache;
 
   float minX_, maxX_;  ///< Минимальное и максимальное значения по оси X.
   float minY_, maxY_;  ///< Минимальное и максимальное значения по оси Y.
   float minZ_, maxZ_;  ///< Минимальное и максимальное значения по оси Z.
   float centerX_, centerY_, centerZ_;  ///< Центр модели.
+  float radius_;  ///< Радиус ограничивающей сферы.
+  WeldStats weldStats_;  ///< Итоги сварки вершин.
 
   std::string filename_;         ///< Имя файла модели.
+  ParseOptions options_;         ///< Параметры загрузки.
   std::vector<float> vertexes_;  ///< Вектор вершин.
-  std::vector<int> edges_;       ///< Вектор рёбер.
+  std::vector<int> edges_;       ///< Треугольники, по три индекса.
+  std::vector<int> outlines_;    ///< Контуры граней.
+  std::vector<int> lines_;       ///< Уникальные рёбра, пары индексов.
   unsigned int vertexCount_;     ///< Количество вершин.
   unsigned int facetsCount_;     ///< Количество граней.
 };
@@ -0,0 +1,86 @@
+#include "thread_pool.h"
+
+namespace s21 {
+ThreadPool::ThreadPool(unsigned int threads)
+    : workers_{},
+      task_{nullptr},
+      count_{},
+      next_{},
+      generation_{},
+      busy_{},
+      error_{},
+      stop_{false} {
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  if (threads == 0) threads = 1;
+  for (unsigned int i = 1; i < threads; i++) {
+    workers_.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) worker.join();
+}
+
+unsigned int ThreadPool::size() const {
+  return static_cast<unsigned int>(workers_.size()) + 1;
+}
+
+void ThreadPool::run(std::size_t count,
+                     const std::function<void(std::size_t)> &task) {
+  if (count == 0) return;
+  std::lock_guard<std::mutex> runLock(runMutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    count_ = count;
+    next_ = 0;
+    error_ = nullptr;
+    busy_ = workers_.size();
+    generation_++;
+  }
+  wake_.notify_all();
+
+  drain();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return busy_ == 0; });
+  task_ = nullptr;
+  if (error_) std::rethrow_exception(error_);
+}
+
+ThreadPool &ThreadPool::shared() {
+  static ThreadPool pool;
+  return pool;
+}
+
+void ThreadPool::workerLoop() {
+  std::size_t seen{};
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+    if (stop_) return;
+    seen = generation_;
+    lock.unlock();
+    drain();
+    lock.lock();
+    if (--busy_ == 0) done_.notify_one();
+  }
+}
+
+void ThreadPool::drain() {
+  for (std::size_t i = next_++; i < count_; i = next_++) {
+    try {
+      (*task_)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) error_ = std::current_exception();
+      next_ = count_;
+    }
+  }
+}
+}  // namespace s21
@@ -0,0 +1,90 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_THREAD_POOL_H_
+#define VIEWER_FRONT_SRC_MODEL_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+/**
+ * @brief Пул потоков для параллельной обработки независимых задач.
+ *
+ * Задачи нумеруются от 0 до count - 1 и раздаются потокам динамически.
+ * Вызывающий поток участвует в работе наравне с рабочими. Вызовы run()
+ * выполняются по очереди; вызывать run() из задачи того же пула нельзя.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @brief Создаёт пул.
+   *
+   * @param threads Общее число потоков вместе с вызывающим; 0 - по числу
+   * аппаратных потоков.
+   */
+  explicit ThreadPool(unsigned int threads = 0);
+
+  /**
+   * @brief Останавливает рабочие потоки.
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief Возвращает число потоков, выполняющих задачи.
+   *
+   * @return unsigned int Число рабочих потоков плюс вызывающий.
+   */
+  [[nodiscard]] unsigned int size() const;
+
+  /**
+   * @brief Выполняет задачи 0..count-1 и ждёт их завершения.
+   *
+   * Если задача бросила исключение, оставшиеся задачи не запускаются, а
+   * первое исключение пробрасывается вызывающему.
+   *
+   * @param count Количество задач.
+   * @param task Функция, получающая номер задачи.
+   */
+  void run(std::size_t count, const std::function<void(std::size_t)> &task);
+
+  /**
+   * @brief Возвращает общий пул по числу аппаратных потоков.
+   *
+   * @return ThreadPool& Общий пул.
+   */
+  static ThreadPool &shared();
+
+ private:
+  /**
+   * @brief Цикл рабочего потока.
+   */
+  void workerLoop();
+
+  /**
+   * @brief Выбирает и выполняет задачи текущего запуска, пока они есть.
+   */
+  void drain();
+
+  std::vector<std::thread> workers_;  ///< Рабочие потоки.
+  std::mutex runMutex_;               ///< Упорядочивает вызовы run().
+  std::mutex mutex_;                  ///< Защищает состояние запуска.
+  std::condition_variable wake_;      ///< Будит рабочие потоки.
+  std::condition_variable done_;      ///< Сообщает о завершении запуска.
+  const std::function<void(std::size_t)> *task_;  ///< Текущая задача.
+  std::size_t count_;                  ///< Число задач текущего запуска.
+  std::atomic<std::size_t> next_;      ///< Номер следующей задачи.
+  std::size_t generation_;             ///< Номер текущего запуска.
+  std::size_t busy_;                   ///< Потоки, не закончившие запуск.
+  std::exception_ptr error_;           ///< Первое исключение задачи.
+  bool stop_;                          ///< Признак остановки пула.
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_THREAD_POOL_H_
@@ -0,0 +1,176 @@
+#include "triangulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "obj_model.h"
+#include "thread_pool.h"
+
+namespace s21 {
+namespace {
+/// Количество индексов контуров, обрабатываемых одной задачей.
+constexpr std::size_t kBlockSize = std::size_t{1} << 16;
+
+/**
+ * @brief Удвоенная ориентированная площадь треугольника на плоскости.
+ */
+float cross(const float *a, const float *b, const float *c) {
+  return (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+}
+
+void fan(const int *polygon, std::size_t size, int *out) {
+  for (std::size_t i = 1; i + 1 < size; i++) {
+    *out++ = polygon[0];
+    *out++ = polygon[i];
+    *out++ = polygon[i + 1];
+  }
+}
+
+/**
+ * @brief Находит начало первой грани, начинающейся не раньше позиции.
+ */
+std::size_t faceStart(const std::vector<int> &outlines, std::size_t position) {
+  while (position > 0 && position < outlines.size() &&
+         outlines[position - 1] != kPrimitiveRestart)
+    position++;
+  return position;
+}
+
+std::size_t faceEnd(const std::vector<int> &outlines, std::size_t position) {
+  while (position < outlines.size() && outlines[position] != kPrimitiveRestart)
+    position++;
+  return position;
+}
+}  // namespace
+
+std::vector<int> Triangulator::triangulate(const std::vector<int> &outlines,
+                                           const std::vector<float> &vertexes,
+                                           ThreadPool &pool) {
+  // Грань принадлежит задаче, в блок которой попадает её первый индекс.
+  // Первый проход считает треугольники граней каждого блока, второй пишет
+  // их по смещениям из префиксной суммы.
+  std::size_t blocks = (outlines.size() + kBlockSize - 1) / kBlockSize;
+  std::vector<std::size_t> offsets(blocks + 1);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t blockEnd = std::min((block + 1) * kBlockSize, outlines.size());
+    std::size_t count = 0;
+    for (std::size_t begin = faceStart(outlines, block * kBlockSize);
+         begin < blockEnd;) {
+      std::size_t end = faceEnd(outlines, begin);
+      if (end - begin >= 3) count += end - begin - 2;
+      begin = end + 1;
+    }
+    offsets[block + 1] = count;
+  });
+  for (std::size_t block = 0; block < blocks; block++)
+    offsets[block + 1] += offsets[block];
+
+  std::vector<int> triangles(offsets.back() * 3);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t blockEnd = std::min((block + 1) * kBlockSize, outlines.size());
+    int *out = triangles.data() + offsets[block] * 3;
+    for (std::size_t begin = faceStart(outlines, block * kBlockSize);
+         begin < blockEnd;) {
+      std::size_t end = faceEnd(outlines, begin);
+      if (end - begin >= 3) {
+        triangulatePolygon(outlines.data() + begin, end - begin, vertexes,
+                           out);
+        out += (end - begin - 2) * 3;
+      }
+      begin = end + 1;
+    }
+  });
+  return triangles;
+}
+
+void Triangulator::triangulatePolygon(const int *polygon, std::size_t size,
+                                      const std::vector<float> &vertexes,
+                                      int *out) {
+  if (size < 3) return;
+  std::size_t vertexCount = vertexes.size() / 3;
+  bool valid = size > 3;
+  for (std::size_t i = 0; valid && i < size; i++)
+    valid = polygon[i] >= 0 && static_cast<std::size_t>(polygon[i]) <
+                                   vertexCount;
+  if (!valid) {
+    fan(polygon, size, out);
+    return;
+  }
+
+  // Нормаль по Ньюэлу устойчива к невыпуклым и слегка неплоским граням.
+  float normal[3]{};
+  for (std::size_t i = 0; i < size; i++) {
+    const float *a = vertexes.data() + polygon[i] * 3;
+    const float *b = vertexes.data() + polygon[(i + 1) % size] * 3;
+    normal[0] += (a[1] - b[1]) * (a[2] + b[2]);
+    normal[1] += (a[2] - b[2]) * (a[0] + b[0]);
+    normal[2] += (a[0] - b[0]) * (a[1] + b[1]);
+  }
+  int drop = 0;
+  for (int axis = 1; axis < 3; axis++)
+    if (std::fabs(normal[axis]) > std::fabs(normal[drop])) drop = axis;
+  if (normal[drop] == 0.0f) {
+    fan(polygon, size, out);
+    return;
+  }
+  // Оси (drop + 1, drop + 2) образуют правую тройку с drop, поэтому обход
+  // против часовой стрелки вокруг нормали даёт положительную площадь.
+  float sign = normal[drop] > 0.0f ? 1.0f : -1.0f;
+  int uAxis = (drop + 1) % 3, vAxis = (drop + 2) % 3;
+
+  thread_local std::vector<float> points{};
+  points.resize(size * 2);
+  for (std::size_t i = 0; i < size; i++) {
+    points[i * 2] = vertexes[polygon[i] * 3 + uAxis];
+    points[i * 2 + 1] = vertexes[polygon[i] * 3 + vAxis];
+  }
+  auto point = [&](std::size_t i) { return points.data() + i * 2; };
+
+  bool convex = true;
+  for (std::size_t i = 0; convex && i < size; i++) {
+    convex = sign * cross(point((i + size - 1) % size), point(i),
+                          point((i + 1) % size)) >= 0.0f;
+  }
+  if (convex) {
+    fan(polygon, size, out);
+    return;
+  }
+
+  thread_local std::vector<std::size_t> ring{};
+  ring.resize(size);
+  for (std::size_t i = 0; i < size; i++) ring[i] = i;
+  std::size_t k = 0;
+  std::size_t misses = 0;
+  while (ring.size() > 3 && misses < ring.size()) {
+    std::size_t n = ring.size();
+    k %= n;
+    std::size_t a = ring[(k + n - 1) % n], b = ring[k], c = ring[(k + 1) % n];
+    bool ear = sign * cross(point(a), point(b), point(c)) > 0.0f;
+    for (std::size_t j = 0; ear && j < n; j++) {
+      std::size_t m = ring[j];
+      if (m == a || m == b || m == c) continue;
+      const float *p = point(m);
+      ear = !(sign * cross(point(a), point(b), p) >= 0.0f &&
+              sign * cross(point(b), point(c), p) >= 0.0f &&
+              sign * cross(point(c), point(a), p) >= 0.0f);
+    }
+    if (!ear) {
+      k++;
+      misses++;
+      continue;
+    }
+    *out++ = polygon[a];
+    *out++ = polygon[b];
+    *out++ = polygon[c];
+    ring.erase(ring.begin() + static_cast<std::ptrdiff_t>(k));
+    k = k == 0 ? 0 : k - 1;
+    misses = 0;
+  }
+  // Оставшийся выпуклый треугольник или вырожденный остаток - веером.
+  for (std::size_t i = 1; i + 1 < ring.size(); i++) {
+    *out++ = polygon[ring[0]];
+    *out++ = polygon[ring[i]];
+    *out++ = polygon[ring[i + 1]];
+  }
+}
+}  // namespace s21
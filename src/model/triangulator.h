@@ -0,0 +1,51 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_TRIANGULATOR_H_
+#define VIEWER_FRONT_SRC_MODEL_TRIANGULATOR_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+class ThreadPool;
+
+/**
+ * @brief Триангуляция граней-многоугольников.
+ *
+ * Грань проецируется на координатную плоскость, наиболее близкую к её
+ * плоскости (нормаль по методу Ньюэла). Выпуклая грань разбивается веером
+ * из первой вершины, невыпуклая - отсечением ушей. Грань из n вершин
+ * всегда даёт n - 2 треугольника, поэтому место под результат
+ * распределяется заранее, и грани обрабатываются параллельно.
+ */
+class Triangulator {
+ public:
+  /**
+   * @brief Триангулирует контуры граней.
+   *
+   * @param outlines Контуры граней, разделённые kPrimitiveRestart.
+   * @param vertexes Координаты вершин, по три на вершину.
+   * @param pool Пул потоков.
+   * @return std::vector<int> Индексы вершин, по три на треугольник, в
+   * порядке следования граней.
+   */
+  static std::vector<int> triangulate(const std::vector<int> &outlines,
+                                      const std::vector<float> &vertexes,
+                                      ThreadPool &pool);
+
+  /**
+   * @brief Триангулирует одну грань.
+   *
+   * Если индексы грани выходят за пределы вершин или грань вырождена,
+   * используется веер.
+   *
+   * @param polygon Индексы вершин грани в порядке обхода.
+   * @param size Количество вершин грани.
+   * @param vertexes Координаты вершин, по три на вершину.
+   * @param out Место под (size - 2) * 3 индексов.
+   */
+  static void triangulatePolygon(const int *polygon, std::size_t size,
+                                 const std::vector<float> &vertexes,
+                                 int *out);
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_TRIANGULATOR_H_
@@ -0,0 +1,244 @@
+#include "vertex_welder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "edge_extractor.h"
+#include "thread_pool.h"
+
+namespace s21 {
+namespace {
+/// Количество вершин или индексов, обрабатываемых одной задачей.
+constexpr std::size_t kBlockSize = std::size_t{1} << 16;
+/// Пустая ячейка хэш-таблицы диапазонов.
+constexpr std::uint64_t kEmptySlot = ~std::uint64_t{0};
+/// Предел номера ячейки сетки, чтобы огромные координаты не переполняли
+/// преобразование в целое.
+constexpr double kCellLimit = 4.0e18;
+
+std::uint32_t mix(std::uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return static_cast<std::uint32_t>(x ^ (x >> 31));
+}
+
+std::uint32_t cellHash(std::int64_t x, std::int64_t y, std::int64_t z) {
+  return mix(static_cast<std::uint64_t>(x) * 0x9E3779B97F4A7C15ull ^
+             static_cast<std::uint64_t>(y) * 0xC2B2AE3D27D4EB4Full ^
+             static_cast<std::uint64_t>(z) * 0x165667B19E3779F9ull);
+}
+
+/**
+ * @brief Хэш точных координат; -0 и +0 считаются одной координатой.
+ */
+std::uint32_t exactHash(const float *point) {
+  std::uint64_t hash = 0;
+  for (int axis = 0; axis < 3; axis++) {
+    float value = point[axis] + 0.0f;
+    std::uint32_t bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    hash = hash * 0x100000001B3ull + bits;
+  }
+  return mix(hash);
+}
+
+bool sameCoordinates(const float *a, const float *b) {
+  return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+}
+
+std::int64_t cellOf(double scaled) {
+  return static_cast<std::int64_t>(
+      std::floor(std::clamp(scaled, -kCellLimit, kCellLimit)));
+}
+
+/**
+ * @brief Открытая хэш-таблица: хэш ячейки -> начало её диапазона в
+ * отсортированных ключах. Заполняется параллельно через CAS.
+ */
+class CellTable {
+ public:
+  CellTable(std::size_t cells, ThreadPool &pool) : mask_{}, slots_{} {
+    std::size_t capacity = 16;
+    while (capacity < cells * 2) capacity *= 2;
+    mask_ = capacity - 1;
+    slots_ = std::make_unique<std::atomic<std::uint64_t>[]>(capacity);
+    std::size_t blocks = (capacity + kBlockSize - 1) / kBlockSize;
+    pool.run(blocks, [&](std::size_t block) {
+      std::size_t end = std::min((block + 1) * kBlockSize, capacity);
+      for (std::size_t i = block * kBlockSize; i < end; i++)
+        slots_[i].store(kEmptySlot, std::memory_order_relaxed);
+    });
+  }
+
+  void insert(std::uint32_t hash, std::uint32_t begin) {
+    std::uint64_t entry = static_cast<std::uint64_t>(hash) << 32 | begin;
+    for (std::size_t slot = hash & mask_;; slot = (slot + 1) & mask_) {
+      std::uint64_t expected = kEmptySlot;
+      if (slots_[slot].compare_exchange_strong(expected, entry,
+                                               std::memory_order_relaxed))
+        return;
+    }
+  }
+
+  /// Начало диапазона ячейки или kEmptySlot, если ячейка пуста.
+  std::uint64_t find(std::uint32_t hash) const {
+    for (std::size_t slot = hash & mask_;; slot = (slot + 1) & mask_) {
+      std::uint64_t entry = slots_[slot].load(std::memory_order_relaxed);
+      if (entry == kEmptySlot) return kEmptySlot;
+      if (entry >> 32 == hash) return entry & 0xFFFFFFFFu;
+    }
+  }
+
+ private:
+  std::size_t mask_;
+  std::unique_ptr<std::atomic<std::uint64_t>[]> slots_;
+};
+}  // namespace
+
+WeldStats VertexWelder::weld(std::vector<float> &vertexes,
+                             std::vector<int> &indexes, float tolerance,
+                             ThreadPool &pool) {
+  std::size_t count = vertexes.size() / 3;
+  WeldStats stats{count, count, 0};
+  if (count < 2 || !(tolerance >= 0.0f)) return stats;
+  std::size_t blocks = (count + kBlockSize - 1) / kBlockSize;
+  bool exact = tolerance == 0.0f;
+  // Сторона ячейки - два допуска: шар допуска задевает не больше двух
+  // ячеек по каждой оси.
+  double inverse = exact ? 0.0 : 1.0 / (2.0 * static_cast<double>(tolerance));
+  auto hashOf = [&](const float *point) {
+    if (exact) return exactHash(point);
+    return cellHash(cellOf(point[0] * inverse), cellOf(point[1] * inverse),
+                    cellOf(point[2] * inverse));
+  };
+
+  // Ключ - хэш ячейки в старших битах и индекс вершины в младших, так что
+  // после сортировки вершины ячейки идут подряд по возрастанию индекса.
+  std::vector<std::uint64_t> keys(count);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, count);
+    for (std::size_t v = block * kBlockSize; v < end; v++)
+      keys[v] = static_cast<std::uint64_t>(hashOf(&vertexes[v * 3])) << 32 | v;
+  });
+  EdgeExtractor::radixSort(keys, 64, pool);
+
+  auto startsCell = [&keys](std::size_t i) {
+    return i == 0 || keys[i] >> 32 != keys[i - 1] >> 32;
+  };
+  std::vector<std::size_t> cells(blocks);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, count);
+    for (std::size_t i = block * kBlockSize; i < end; i++)
+      cells[block] += startsCell(i);
+  });
+  std::size_t cellCount = 0;
+  for (std::size_t value : cells) cellCount += value;
+  CellTable table(cellCount, pool);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, count);
+    for (std::size_t i = block * kBlockSize; i < end; i++) {
+      if (startsCell(i))
+        table.insert(static_cast<std::uint32_t>(keys[i] >> 32),
+                     static_cast<std::uint32_t>(i));
+    }
+  });
+
+  // Для каждой вершины - соседка с наименьшим индексом в пределах допуска.
+  std::vector<std::uint32_t> target(count);
+  float squared = tolerance * tolerance;
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, count);
+    for (std::size_t v = block * kBlockSize; v < end; v++) {
+      const float *point = &vertexes[v * 3];
+      std::size_t best = v;
+      auto scan = [&](std::uint32_t hash) {
+        std::uint64_t begin = table.find(hash);
+        if (begin == kEmptySlot) return;
+        for (std::size_t i = begin; i < count && keys[i] >> 32 == hash; i++) {
+          std::size_t u = keys[i] & 0xFFFFFFFFu;
+          if (u >= best) break;
+          const float *other = &vertexes[u * 3];
+          if (exact) {
+            if (sameCoordinates(point, other)) best = u;
+            continue;
+          }
+          float dx = point[0] - other[0], dy = point[1] - other[1];
+          float dz = point[2] - other[2];
+          if (dx * dx + dy * dy + dz * dz <= squared) best = u;
+        }
+      };
+      if (exact || !std::isfinite(point[0] + point[1] + point[2])) {
+        if (exact) scan(exactHash(point));
+      } else {
+        std::int64_t cell[3], side[3];
+        for (int axis = 0; axis < 3; axis++) {
+          double scaled = point[axis] * inverse;
+          cell[axis] = cellOf(scaled);
+          side[axis] = scaled - std::floor(scaled) < 0.5 ? -1 : 1;
+        }
+        for (int corner = 0; corner < 8; corner++) {
+          scan(cellHash(cell[0] + (corner & 1 ? side[0] : 0),
+                        cell[1] + (corner & 2 ? side[1] : 0),
+                        cell[2] + (corner & 4 ? side[2] : 0)));
+        }
+      }
+      target[v] = static_cast<std::uint32_t>(best);
+    }
+  });
+
+  // Соседка всегда левее, поэтому один проход по возрастанию сводит
+  // цепочки к представителям.
+  for (std::size_t v = 0; v < count; v++) target[v] = target[target[v]];
+
+  std::vector<std::size_t> offsets(blocks + 1);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, count);
+    for (std::size_t v = block * kBlockSize; v < end; v++)
+      offsets[block + 1] += target[v] == v;
+  });
+  for (std::size_t block = 0; block < blocks; block++)
+    offsets[block + 1] += offsets[block];
+  std::size_t kept = offsets.back();
+
+  std::vector<std::uint32_t> remap(count);
+  std::vector<float> welded(kept * 3);
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, count);
+    std::size_t next = offsets[block];
+    for (std::size_t v = block * kBlockSize; v < end; v++) {
+      if (target[v] != v) continue;
+      remap[v] = static_cast<std::uint32_t>(next);
+      std::copy(&vertexes[v * 3], &vertexes[v * 3] + 3, &welded[next * 3]);
+      next++;
+    }
+  });
+  pool.run(blocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, count);
+    for (std::size_t v = block * kBlockSize; v < end; v++) {
+      if (target[v] != v) remap[v] = remap[target[v]];
+    }
+  });
+
+  int removed = static_cast<int>(count - kept);
+  std::size_t indexBlocks = (indexes.size() + kBlockSize - 1) / kBlockSize;
+  pool.run(indexBlocks, [&](std::size_t block) {
+    std::size_t end = std::min((block + 1) * kBlockSize, indexes.size());
+    for (std::size_t i = block * kBlockSize; i < end; i++) {
+      int index = indexes[i];
+      if (index < 0) continue;
+      indexes[i] = static_cast<std::size_t>(index) < count
+                       ? static_cast<int>(remap[index])
+                       : index - removed;
+    }
+  });
+
+  vertexes.swap(welded);
+  stats.vertexesAfter = kept;
+  stats.savedBytes = (count - kept) * 3 * sizeof(float);
+  return stats;
+}
+}  // namespace s21
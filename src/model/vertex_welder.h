@@ -0,0 +1,54 @@
+#ifndef VIEWER_FRONT_SRC_MODEL_VERTEX_WELDER_H_
+#define VIEWER_FRONT_SRC_MODEL_VERTEX_WELDER_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+class ThreadPool;
+
+/**
+ * @brief Итоги сварки вершин.
+ */
+struct WeldStats {
+  std::size_t vertexesBefore{};  ///< Количество вершин до сварки.
+  std::size_t vertexesAfter{};   ///< Количество вершин после сварки.
+  std::size_t savedBytes{};      ///< Освобождённая память координат.
+};
+
+/**
+ * @brief Сварка совпадающих и близких вершин через пространственный хэш.
+ *
+ * Вершины раскладываются по ячейкам сетки со стороной не меньше двух
+ * допусков, ключи ячеек сортируются параллельной поразрядной сортировкой,
+ * а по отсортированным ключам строится хэш-таблица диапазонов ячеек.
+ * Шар допуска вокруг вершины задевает не больше двух ячеек по каждой оси,
+ * поэтому соседей достаточно искать в восьми ячейках.
+ *
+ * Каждая вершина привязывается к вершине с наименьшим индексом среди
+ * соседей в пределах допуска, а та - к своему представителю, поэтому
+ * результат не зависит от числа потоков, а порядок оставшихся вершин
+ * сохраняется.
+ */
+class VertexWelder {
+ public:
+  /**
+   * @brief Сваривает вершины и перенумеровывает индексы граней.
+   *
+   * Отрицательные индексы (kPrimitiveRestart) не меняются, индексы за
+   * пределами массива вершин остаются за его пределами.
+   *
+   * @param vertexes Координаты вершин, по три на вершину; сжимаются.
+   * @param indexes Индексы вершин, которые нужно перенумеровать.
+   * @param tolerance Допуск: вершины ближе него сливаются; 0 - сливаются
+   * только побитово совпадающие координаты.
+   * @param pool Пул потоков.
+   * @return WeldStats Итоги сварки.
+   */
+  static WeldStats weld(std::vector<float> &vertexes,
+                        std::vector<int> &indexes, float tolerance,
+                        ThreadPool &pool);
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_MODEL_VERTEX_WELDER_H_
@@ -6,28 +6,31 @@
 #include <gtest/gtest.h>
 
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <random>
+#include <thread>
 
-void CreateTestObjFile() {
-  std::ofstream file("test.obj");
-  file << "# Simple cube\n";
-  file << "v -1.0 -1.0 -1.0\n";
-  file << "v  1.0 -1.0 -1.0\n";
-  file << "v  1.0  1.0 -1.0\n";
-  file << "v -1.0  1.0 -1.0\n";
-  file << "v -1.0 -1.0  1.0\n";
-  file << "v  1.0 -1.0  1.0\n";
-  file << "v  1.0  1.0  1.0\n";
-  file << "v -1.0  1.0  1.0\n";
-  file << "f 1 2 3 4\n";
-  file << "f 5 6 7 8\n";
-  file << "f 1 2 6 5\n";
-  file << "f 2 3 7 6\n";
-  file << "f 3 4 8 7\n";
-  file << "f 4 1 5 8\n";
-  file.close();
-}
+const char kCubeObj[] =
+    "# Simple cube\n"
+    "v -1.0 -1.0 -1.0\n"
+    "v  1.0 -1.0 -1.0\n"
+    "v  1.0  1.0 -1.0\n"
+    "v -1.0  1.0 -1.0\n"
+    "v -1.0 -1.0  1.0\n"
+    "v  1.0 -1.0  1.0\n"
+    "v  1.0  1.0  1.0\n"
+    "v -1.0  1.0  1.0\n"
+    "f 1 2 3 4\n"
+    "f 5 6 7 8\n"
+    "f 1 2 6 5\n"
+    "f 2 3 7 6\n"
+    "f 3 4 8 7\n"
+    "f 4 1 5 8\n";
+
+void CreateTestObjFile() { std::ofstream("test.obj") << kCubeObj; }
 
 void DeleteTestObjFile() { std::remove("test.obj"); }
 
@@ -41,10 +44,8 @@ bool CompareMatrices(const float *a, const float *b, float epsilon = 1e-5) {
 }
 
 TEST(ModelTest, Constructor) {
-  CreateTestObjFile();
   s21::Model model;
   EXPECT_EQ((int)model.getVertexCount(), 0);
-  CreateTestObjFile();
 }
 
 TEST(ModelTest, DefaultConstructorTest) {
@@ -69,37 +70,886 @@ TEST(ModelTest, ConstructorWithFilenameTest) {
   DeleteTestObjFile();
 }
 
-TEST(ModelTest, GetVertexesTest) {
+TEST(ModelTest, FromTextMatchesFile) {
   CreateTestObjFile();
-  s21::Model model("test.obj");
+  s21::Model file("test.obj");
+  s21::Model text = s21::Model::fromText(kCubeObj);
+
+  EXPECT_EQ(text.getVertexes(), file.getVertexes());
+  EXPECT_EQ(text.getEdges(), file.getEdges());
+  EXPECT_EQ(text.getLines(), file.getLines());
+  EXPECT_EQ(text.getFacetsCount(), file.getFacetsCount());
+  EXPECT_FLOAT_EQ(text.getMaxZ(), file.getMaxZ());
+
+  DeleteTestObjFile();
+}
+
+TEST(ModelTest, FromTextRejectsBadNumbers) {
+  EXPECT_THROW(s21::Model::fromText("v 1 x 3\n"), std::invalid_argument);
+  EXPECT_EQ((int)s21::Model::fromText("").getVertexCount(), 0);
+}
+
+TEST(ModelTest, GetVertexesTest) {
+  s21::Model model = s21::Model::fromText(kCubeObj);
 
   const std::vector<float> &vertexes = model.getVertexes();
   EXPECT_EQ((int)vertexes.size(), 24);
+}
 
+TEST(ModelTest, GetEdgesTest) {
+  s21::Model model = s21::Model::fromText(kCubeObj);
+
+  // Шесть четырёхугольников куба: по два треугольника на грань, контуры
+  // из четырёх индексов и разделителя, двенадцать уникальных рёбер.
+  const std::vector<int> &edges = model.getEdges();
+  EXPECT_EQ((int)edges.size(), 36);
+  EXPECT_EQ((int)model.getFacetsCount(), 6);
+  EXPECT_EQ((int)model.getOutlines().size(), 30);
+  EXPECT_EQ((int)model.getLines().size(), 24);
+}
+
+TEST(ModelTest, VertexesAndEdgesValuesTest) {
+  s21::Model model = s21::Model::fromText(
+      "v 0.5 -1.25 3\n"
+      "v 1 2 3.5\n"
+      "vn 0 0 1\n"
+      "v -4 0.25 -0.75\n"
+      "f 1/1/1 2/2/1 3/3/1\n"
+      "f 3//1 2//1 1//1\n");
+  std::vector<float> expectedVertexes = {0.5f, -1.25f, 3.0f,  1.0f, 2.0f,
+                                         3.5f, -4.0f,  0.25f, -0.75f};
+  std::vector<int> expectedEdges = {0, 1, 2, 2, 1, 0};
+
+  EXPECT_EQ((int)model.getVertexCount(), 3);
+  EXPECT_EQ((int)model.getFacetsCount(), 2);
+  EXPECT_EQ(model.getVertexes(), expectedVertexes);
+  EXPECT_EQ(model.getEdges(), expectedEdges);
+  EXPECT_FLOAT_EQ(model.getMinX(), -4.0f);
+  EXPECT_FLOAT_EQ(model.getMaxY(), 2.0f);
+  EXPECT_FLOAT_EQ(model.getMaxZ(), 3.5f);
+}
+
+TEST(ModelTest, ReadFromPipeTest) {
+  std::remove("test_pipe.obj");
+  ASSERT_EQ(mkfifo("test_pipe.obj", 0600), 0);
+  std::thread writer([] {
+    std::ofstream pipe("test_pipe.obj");
+    pipe << "v 1 2 3\nv 4 5 6\nv 7 8 9\nf 1/1 2/2 3/3\n";
+  });
+
+  s21::Model model("test_pipe.obj");
+  writer.join();
+
+  EXPECT_EQ((int)model.getVertexCount(), 3);
+  EXPECT_EQ((int)model.getFacetsCount(), 1);
+  EXPECT_EQ((int)model.getEdges().size(), 3);
+  EXPECT_FLOAT_EQ(model.getMaxZ(), 9.0f);
+
+  std::remove("test_pipe.obj");
+}
+
+TEST(ModelTest, ParallelChunksKeepFileOrder) {
+  const int count = 200000;
+  {
+    std::ofstream file("test_chunks.obj");
+    for (int i = 0; i < count; i++) {
+      file << "v " << i << " " << -i << " " << i % 1000 << "\n";
+      file << "f " << i + 1 << "/1 " << i + 2 << "/1 " << i + 3 << "/1\n";
+    }
+  }
+
+  s21::ParseOptions options;
+  options.threads = 3;
+  s21::Model model("test_chunks.obj", options);
+  const std::vector<float> &vertexes = model.getVertexes();
+  const std::vector<int> &edges = model.getEdges();
+
+  ASSERT_EQ((int)model.getVertexCount(), count);
+  ASSERT_EQ((int)vertexes.size(), count * 3);
+  ASSERT_EQ((int)edges.size(), count * 3);
+  for (int i = 0; i < count; i += 997) {
+    EXPECT_FLOAT_EQ(vertexes[i * 3], (float)i);
+    EXPECT_FLOAT_EQ(vertexes[i * 3 + 1], (float)-i);
+    EXPECT_EQ(edges[i * 3], i);
+    EXPECT_EQ(edges[i * 3 + 2], i + 2);
+  }
+  EXPECT_FLOAT_EQ(model.getMaxX(), (float)(count - 1));
+  EXPECT_FLOAT_EQ(model.getMinY(), (float)(1 - count));
+  EXPECT_FLOAT_EQ(model.getMaxZ(), 999.0f);
+
+  std::remove("test_chunks.obj");
+}
+
+TEST(DecompressorTest, GzipMatchesPlainFile) {
+  const int count = 200000;
+  std::string text{};
+  for (int i = 0; i < count; i++) {
+    text += "v " + std::to_string(i) + " " + std::to_string(-i) + " 1.5\n";
+    text += "f " + std::to_string(i + 1) + " " + std::to_string(i + 2) +
+            " " + std::to_string(i + 3) + "\n";
+  }
+  std::ofstream("test_plain.obj") << text;
+  gzFile gz = gzopen("test_packed.obj.gz", "wb1");
+  ASSERT_NE(gz, nullptr);
+  gzwrite(gz, text.data(), static_cast<unsigned>(text.size()));
+  gzclose(gz);
+
+  s21::MeshStream stream;
+  s21::LoadProgress progress;
+  s21::ParseOptions options;
+  options.threads = 3;
+  options.stream = &stream;
+  options.progress = &progress;
+  s21::Model packed("test_packed.obj.gz", options);
+  s21::Model plain("test_plain.obj");
+
+  EXPECT_EQ(packed.getVertexCount(), plain.getVertexCount());
+  EXPECT_EQ(packed.getFacetsCount(), plain.getFacetsCount());
+  EXPECT_TRUE(packed.getVertexes() == plain.getVertexes());
+  EXPECT_TRUE(packed.getEdges() == plain.getEdges());
+  EXPECT_TRUE(packed.getLines() == plain.getLines());
+  EXPECT_FLOAT_EQ(packed.getMinY(), plain.getMinY());
+  EXPECT_DOUBLE_EQ(progress.fraction(), 1.0);
+
+  std::vector<int> outlines{};
+  for (const s21::MeshBatch &batch : stream.take())
+    outlines.insert(outlines.end(), batch.outlines.begin(),
+                    batch.outlines.end());
+  EXPECT_TRUE(outlines == plain.getOutlines());
+  EXPECT_EQ((int)stream.expectedIndexes(), (int)text.size() / 16);
+
+  std::remove("test_plain.obj");
+  std::remove("test_packed.obj.gz");
+}
+
+TEST(DecompressorTest, TruncatedGzipThrows) {
+  std::string text(1 << 20, '\n');
+  gzFile gz = gzopen("test_cut.obj.gz", "wb");
+  ASSERT_NE(gz, nullptr);
+  gzwrite(gz, text.data(), static_cast<unsigned>(text.size()));
+  gzclose(gz);
+  truncate("test_cut.obj.gz", 100);
+
+  EXPECT_THROW(s21::Model("test_cut.obj.gz"), std::invalid_argument);
+  std::remove("test_cut.obj.gz");
+}
+
+TEST(DecompressorTest, DetectsFormatByExtension) {
+  EXPECT_EQ(s21::Decompressor::detect("a.obj"), s21::Decompressor::kNone);
+  EXPECT_EQ(s21::Decompressor::detect("a.obj.gz"), s21::Decompressor::kGzip);
+  EXPECT_EQ(s21::Decompressor::detect("a.obj.zst"), s21::Decompressor::kZstd);
+  EXPECT_TRUE(s21::Decompressor::supported(s21::Decompressor::kGzip));
+  EXPECT_THROW(s21::Model("missing.obj.gz"), std::invalid_argument);
+  if (!s21::Decompressor::supported(s21::Decompressor::kZstd)) {
+    EXPECT_THROW(s21::Model("missing.obj.zst"), std::invalid_argument);
+  }
+}
+
+TEST(MeshGeneratorTest, SeedDeterminesText) {
+  using s21::MeshGenerator;
+  std::string first = MeshGenerator::generate(MeshGenerator::kSoup, 100, 7);
+  EXPECT_EQ(first, MeshGenerator::generate(MeshGenerator::kSoup, 100, 7));
+  EXPECT_NE(first, MeshGenerator::generate(MeshGenerator::kSoup, 100, 8));
+  EXPECT_EQ(MeshGenerator::parseShape("terrain"), MeshGenerator::kTerrain);
+  EXPECT_THROW(MeshGenerator::parseShape("cube"), std::invalid_argument);
+}
+
+TEST(MeshGeneratorTest, ModelMatchesReportedSize) {
+  using s21::MeshGenerator;
+  for (MeshGenerator::Shape shape :
+       {MeshGenerator::kSphere, MeshGenerator::kTerrain, MeshGenerator::kSoup,
+        MeshGenerator::kCloud}) {
+    MeshGenerator::Size size = MeshGenerator::size(shape, 5000);
+    s21::Model model =
+        s21::Model::fromText(MeshGenerator::generate(shape, 5000, 1));
+    EXPECT_EQ(model.getVertexCount(), size.vertexes);
+    EXPECT_EQ(model.getFacetsCount(), size.faces);
+    std::size_t corners = shape == MeshGenerator::kTerrain ? 6 : 3;
+    EXPECT_EQ(model.getEdges().size(), size.faces * corners);
+  }
+}
+
+TEST(MeshGeneratorTest, ParsesClosedSphereAtScale) {
+  using s21::MeshGenerator;
+  MeshGenerator::Size size = MeshGenerator::writeFile(
+      "test_sphere.obj", MeshGenerator::kSphere, 400000, 3);
+  s21::ParseOptions options;
+  options.threads = 3;
+  s21::Model model("test_sphere.obj", options);
+
+  EXPECT_GE(size.faces, 400000u);
+  EXPECT_EQ(model.getVertexCount(), size.vertexes);
+  EXPECT_EQ(model.getFacetsCount(), size.faces);
+  // У замкнутой треугольной сетки каждое ребро общее для двух граней.
+  EXPECT_EQ(model.getLines().size() / 2, size.faces * 3 / 2);
+  EXPECT_NEAR(model.getMaxY(), 1.0f, 0.01f);
+  EXPECT_NEAR(model.getMinX(), -1.0f, 0.01f);
+
+  std::remove("test_sphere.obj");
+}
+
+TEST(MeshStreamTest, BatchesComeInFileOrder) {
+  s21::MeshStream stream;
+  stream.begin(2, 640);
+  s21::MeshBatch second{};
+  second.outlines = {1};
+  stream.publish(1, second);
+  stream.finishChunk(1);
+  EXPECT_TRUE(stream.take().empty());
+
+  s21::MeshBatch first{};
+  first.outlines = {0};
+  stream.publish(0, first);
+  std::vector<s21::MeshBatch> batches = stream.take();
+  ASSERT_EQ((int)batches.size(), 1);
+  EXPECT_EQ(batches[0].outlines[0], 0);
+
+  stream.finishChunk(0);
+  batches = stream.take();
+  ASSERT_EQ((int)batches.size(), 1);
+  EXPECT_EQ(batches[0].outlines[0], 1);
+  EXPECT_EQ((int)stream.expectedVertexes(), 10);
+}
+
+TEST(MeshStreamTest, BatchesRebuildModel) {
+  const int count = 200000;
+  {
+    std::ofstream file("test_stream.obj");
+    for (int i = 0; i < count; i++) {
+      file << "v " << i << " " << -i << " " << i % 1000 << "\n";
+      file << "f " << i + 1 << " " << i + 2 << " " << i + 3 << "\n";
+    }
+  }
+
+  s21::MeshStream stream;
+  s21::ParseOptions options;
+  options.threads = 3;
+  options.stream = &stream;
+  s21::Model model("test_stream.obj", options);
+  std::vector<s21::MeshBatch> batches = stream.take();
+
+  std::vector<float> vertexes{};
+  std::vector<int> outlines{};
+  float maxX = -HUGE_VALF, minY = HUGE_VALF;
+  for (const s21::MeshBatch &batch : batches) {
+    EXPECT_LE(batch.vertexes.size(), s21::MeshStream::kBatchVertexes * 3);
+    vertexes.insert(vertexes.end(), batch.vertexes.begin(),
+                    batch.vertexes.end());
+    outlines.insert(outlines.end(), batch.outlines.begin(),
+                    batch.outlines.end());
+    maxX = std::max(maxX, batch.max[0]);
+    minY = std::min(minY, batch.min[1]);
+  }
+  EXPECT_GT((int)batches.size(), 2);
+  EXPECT_TRUE(vertexes == model.getVertexes());
+  EXPECT_TRUE(outlines == model.getOutlines());
+  EXPECT_FLOAT_EQ(maxX, model.getMaxX());
+  EXPECT_FLOAT_EQ(minY, model.getMinY());
+  EXPECT_TRUE(stream.take().empty());
+
+  std::remove("test_stream.obj");
+}
+
+TEST(MeshCacheTest, CacheIsWrittenAndReused) {
+  CreateTestObjFile();
+  std::string cachePath = s21::MeshCache::cachePath("test.obj");
+  std::remove(cachePath.c_str());
+  s21::ParseOptions options;
+  options.useCache = true;
+
+  s21::Model parsed("test.obj", options);
+  std::ifstream cacheFile(cachePath, std::ios::binary);
+  ASSERT_TRUE(cacheFile.is_open());
+  cacheFile.close();
+
+  // Подменяем первую координату в кэше, чтобы убедиться, что данные
+  // действительно берутся из него, а не из OBJ-файла.
+  std::fstream patch(cachePath,
+                     std::ios::binary | std::ios::in | std::ios::out);
+  patch.seekg(0, std::ios::end);
+  std::size_t tail = 24 + parsed.getEdges().size() +
+                     parsed.getOutlines().size() + parsed.getLines().size();
+  auto dataOffset = static_cast<std::streamoff>(patch.tellg()) -
+                    static_cast<std::streamoff>(tail * sizeof(float));
+  float marker = 42.0f;
+  patch.seekp(dataOffset);
+  patch.write(reinterpret_cast<const char *>(&marker), sizeof(marker));
+  patch.close();
+
+  s21::Model cached("test.obj", options);
+  EXPECT_EQ(cached.getVertexCount(), parsed.getVertexCount());
+  EXPECT_EQ(cached.getFacetsCount(), parsed.getFacetsCount());
+  EXPECT_EQ(cached.getEdges(), parsed.getEdges());
+  EXPECT_EQ(cached.getOutlines(), parsed.getOutlines());
+  EXPECT_EQ(cached.getLines(), parsed.getLines());
+  EXPECT_FLOAT_EQ(cached.getVertexes()[0], 42.0f);
+  EXPECT_FLOAT_EQ(cached.getVertexes()[1], parsed.getVertexes()[1]);
+  EXPECT_FLOAT_EQ(cached.getMinX(), parsed.getMinX());
+  EXPECT_FLOAT_EQ(cached.getMaxZ(), parsed.getMaxZ());
+  EXPECT_FLOAT_EQ(cached.getRadius(), parsed.getRadius());
+
+  std::remove(cachePath.c_str());
   DeleteTestObjFile();
 }
 
-TEST(ModelTest, GetEdgesTest) {
+TEST(MeshCacheTest, ChangedFileInvalidatesCache) {
   CreateTestObjFile();
-  s21::Model model("test.obj");
+  std::string cachePath = s21::MeshCache::cachePath("test.obj");
+  s21::ParseOptions options;
+  options.useCache = true;
+  s21::Model first("test.obj", options);
 
-  const std::vector<int> &edges = model.getEdges();
-  EXPECT_EQ((int)edges.size(), 6);
+  std::ofstream file("test.obj", std::ios::app);
+  file << "v 5.0 5.0 5.0\n";
+  file.close();
+
+  s21::Model second("test.obj", options);
+  EXPECT_EQ((int)second.getVertexCount(), 9);
+  EXPECT_FLOAT_EQ(second.getMaxX(), 5.0f);
 
+  std::remove(cachePath.c_str());
   DeleteTestObjFile();
 }
 
-TEST(ModelTest, WrongFilename) {
+TEST(MeshCacheTest, CancelledSaveLeavesNoCache) {
   CreateTestObjFile();
-  EXPECT_ANY_THROW(s21::Model model("test.ob"));
+  std::string cachePath = s21::MeshCache::cachePath("test.obj");
+  std::remove(cachePath.c_str());
+  s21::Model parsed("test.obj");
+  s21::LoadProgress progress;
+  progress.cancel();
 
+  EXPECT_THROW(s21::MeshCache::save("test.obj", parsed, &progress),
+               s21::LoadCancelled);
+  EXPECT_FALSE(std::ifstream(cachePath).is_open());
+  EXPECT_FALSE(std::ifstream(cachePath + ".tmp").is_open());
   DeleteTestObjFile();
 }
 
-TEST(CameraTest, ModelMatrixCalculation) {
+TEST(ModelTest, WrongFilename) {
+  EXPECT_ANY_THROW(s21::Model model("test.ob"));
+}
+
+TEST(BoundingBoxTest, SimdMatchesScalar) {
+  std::mt19937 random(11);
+  std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+  s21::ThreadPool pool(3);
+  // Количества не кратны ширине регистров, чтобы проверить хвосты.
+  for (std::size_t count : {0u, 1u, 7u, 13u, 100003u}) {
+    std::vector<float> vertexes(count * 3);
+    for (float &value : vertexes) value = coordinate(random);
+    s21::BoundingBox expected{};
+    for (std::size_t i = 0; i < vertexes.size(); i++) {
+      expected.min[i % 3] = std::min(expected.min[i % 3], vertexes[i]);
+      expected.max[i % 3] = std::max(expected.max[i % 3], vertexes[i]);
+    }
+    s21::BoundingBox single =
+        s21::BoundingBox::compute(vertexes.data(), count);
+    s21::BoundingBox parallel = s21::BoundingBox::compute(vertexes, pool);
+    for (int axis = 0; axis < 3; axis++) {
+      EXPECT_EQ(single.min[axis], expected.min[axis]);
+      EXPECT_EQ(single.max[axis], expected.max[axis]);
+      EXPECT_EQ(parallel.min[axis], expected.min[axis]);
+      EXPECT_EQ(parallel.max[axis], expected.max[axis]);
+    }
+    EXPECT_EQ(single.empty(), count == 0);
+  }
+}
+
+TEST(BoundingBoxTest, ModelBoundsAreSeededFromVertexes) {
+  s21::Model positive =
+      s21::Model::fromText("v 2 3 4\nv 6 5 8\nf 1 2 1\n");
+  EXPECT_FLOAT_EQ(positive.getMinX(), 2.0f);
+  EXPECT_FLOAT_EQ(positive.getMinY(), 3.0f);
+  EXPECT_FLOAT_EQ(positive.getMinZ(), 4.0f);
+  EXPECT_FLOAT_EQ(positive.getCenterX(), 4.0f);
+  EXPECT_FLOAT_EQ(positive.getCenterZ(), 6.0f);
+  EXPECT_FLOAT_EQ(positive.getRadius(), 3.0f);
+
+  s21::Model negative = s21::Model::fromText("v -2 -3 -4\nv -6 -5 -8\n");
+  EXPECT_FLOAT_EQ(negative.getMaxX(), -2.0f);
+  EXPECT_FLOAT_EQ(negative.getMaxY(), -3.0f);
+  EXPECT_FLOAT_EQ(negative.getMaxZ(), -4.0f);
+
+  s21::Model cube = s21::Model::fromText(kCubeObj);
+  EXPECT_FLOAT_EQ(cube.getCenterY(), 0.0f);
+  EXPECT_FLOAT_EQ(cube.getRadius(), std::sqrt(3.0f));
+}
+
+TEST(VertexWelderTest, ExactDuplicatesCollapse) {
+  // Куб, у каждой грани которого свои четыре вершины.
+  const int corners[6][4] = {{1, 2, 3, 4}, {5, 6, 7, 8}, {1, 2, 6, 5},
+                             {2, 3, 7, 6}, {3, 4, 8, 7}, {4, 1, 5, 8}};
+  const float points[8][3] = {{-1, -1, -1}, {1, -1, -1}, {1, 1, -1},
+                              {-1, 1, -1},  {-1, -1, 1}, {1, -1, 1},
+                              {1, 1, 1},    {-1, 1, 1}};
+  std::ostringstream text;
+  for (const auto &face : corners) {
+    for (int corner : face) {
+      const float *point = points[corner - 1];
+      text << "v " << point[0] << ' ' << point[1] << ' ' << point[2] << '\n';
+    }
+  }
+  for (int face = 0; face < 6; face++) {
+    text << "f " << face * 4 + 1 << ' ' << face * 4 + 2 << ' '
+         << face * 4 + 3 << ' ' << face * 4 + 4 << '\n';
+  }
+
+  s21::ParseOptions options;
+  s21::Model unwelded = s21::Model::fromText(text.str(), options);
+  EXPECT_EQ((int)unwelded.getVertexCount(), 24);
+  EXPECT_EQ(unwelded.getWeldStats().vertexesAfter, 24u);
+
+  options.weldTolerance = 0.0f;
+  s21::Model welded = s21::Model::fromText(text.str(), options);
+  s21::Model cube = s21::Model::fromText(kCubeObj);
+  EXPECT_EQ((int)welded.getVertexCount(), 8);
+  EXPECT_EQ(welded.getWeldStats().vertexesBefore, 24u);
+  EXPECT_EQ(welded.getWeldStats().savedBytes, 16 * 3 * sizeof(float));
+  EXPECT_EQ(welded.getVertexes().size(), 24u);
+  EXPECT_EQ(welded.getOutlines(), cube.getOutlines());
+  EXPECT_EQ(welded.getEdges(), cube.getEdges());
+  EXPECT_EQ(welded.getLines().size(), cube.getLines().size());
+  EXPECT_FLOAT_EQ(welded.getRadius(), cube.getRadius());
+}
+
+TEST(VertexWelderTest, ToleranceMergesClustersDeterministically) {
+  std::mt19937 random(5);
+  std::uniform_real_distribution<float> jitter(-0.001f, 0.001f);
+  std::vector<float> vertexes;
+  std::vector<int> indexes;
+  // Скопления по четыре точки в узлах решётки с шагом 1; узлы лежат на
+  // границах ячеек сетки, так что соседей приходится искать в соседних
+  // ячейках.
+  const int kClusters = 1000;
+  for (int copy = 0; copy < 4; copy++) {
+    for (int cluster = 0; cluster < kClusters; cluster++) {
+      vertexes.push_back(static_cast<float>(cluster % 10) + jitter(random));
+      vertexes.push_back(static_cast<float>(cluster / 10 % 10) +
+                         jitter(random));
+      vertexes.push_back(static_cast<float>(cluster / 100) + jitter(random));
+      indexes.push_back(copy * kClusters + cluster);
+      if (cluster % 3 == 2) indexes.push_back(s21::kPrimitiveRestart);
+    }
+  }
+  indexes.push_back(4 * kClusters + 2);
+
+  s21::ThreadPool single(1), several(4);
+  std::vector<float> first = vertexes, second = vertexes;
+  std::vector<int> firstIndexes = indexes, secondIndexes = indexes;
+  s21::WeldStats stats =
+      s21::VertexWelder::weld(first, firstIndexes, 0.01f, single);
+  s21::VertexWelder::weld(second, secondIndexes, 0.01f, several);
+  EXPECT_EQ(stats.vertexesBefore, 4u * kClusters);
+  EXPECT_EQ(stats.vertexesAfter, static_cast<std::size_t>(kClusters));
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(firstIndexes, secondIndexes);
+
+  // Представитель скопления - его первая точка.
+  EXPECT_TRUE(std::equal(first.begin(), first.end(), vertexes.begin()));
+  for (std::size_t i = 0; i < indexes.size(); i++) {
+    if (indexes[i] == s21::kPrimitiveRestart) {
+      EXPECT_EQ(firstIndexes[i], s21::kPrimitiveRestart);
+    } else if (indexes[i] < 4 * kClusters) {
+      EXPECT_EQ(firstIndexes[i], indexes[i] % kClusters);
+    } else {
+      EXPECT_EQ(firstIndexes[i], kClusters + 2);
+    }
+  }
+
+  std::vector<float> untouched = vertexes;
+  std::vector<int> untouchedIndexes = indexes;
+  stats = s21::VertexWelder::weld(untouched, untouchedIndexes, -1.0f, single);
+  EXPECT_EQ(stats.savedBytes, 0u);
+  EXPECT_EQ(untouched, vertexes);
+  EXPECT_EQ(untouchedIndexes, indexes);
+}
+
+TEST(MeshSimplifierTest, FlatGridKeepsOutline) {
+  // Плоская сетка 40 x 40 квадратов: упрощение не должно ни сдвинуть
+  // вершины из плоскости, ни стянуть края.
+  const int kSide = 40;
+  std::vector<float> vertexes{};
+  std::vector<int> triangles{};
+  for (int y = 0; y <= kSide; y++) {
+    for (int x = 0; x <= kSide; x++)
+      vertexes.insert(vertexes.end(), {(float)x, (float)y, 0.0f});
+  }
+  for (int y = 0; y < kSide; y++) {
+    for (int x = 0; x < kSide; x++) {
+      int v = y * (kSide + 1) + x, up = v + kSide + 1;
+      triangles.insert(triangles.end(), {v, v + 1, up + 1, v, up + 1, up});
+    }
+  }
+
+  s21::ThreadPool pool(2);
+  s21::MeshLod lod = s21::MeshSimplifier::simplify(
+      vertexes, triangles, triangles.size() / 3 / 10, pool);
+  EXPECT_LE(lod.triangles.size() / 3, triangles.size() / 3 / 10);
+  EXPECT_FALSE(lod.lines.empty());
+  EXPECT_NEAR(lod.error, 0.0f, 1e-3f);
+  s21::BoundingBox box =
+      s21::BoundingBox::compute(lod.vertexes.data(), lod.vertexes.size() / 3);
+  EXPECT_FLOAT_EQ(box.min[0], 0.0f);
+  EXPECT_FLOAT_EQ(box.max[0], (float)kSide);
+  EXPECT_FLOAT_EQ(box.max[1], (float)kSide);
+  EXPECT_FLOAT_EQ(box.max[2], 0.0f);
+  for (int index : lod.triangles) {
+    ASSERT_GE(index, 0);
+    ASSERT_LT(index, (int)(lod.vertexes.size() / 3));
+  }
+}
+
+TEST(MeshSimplifierTest, DropsTrianglesOutsideVertexes) {
+  using s21::MeshGenerator;
+  // Сетка делится на участки, и индексы используются до их построения.
+  s21::Model model = s21::Model::fromText(
+      MeshGenerator::generate(MeshGenerator::kSphere, 40000, 3));
+  const std::vector<int> &clean = model.getEdges();
+  int vertexCount = static_cast<int>(model.getVertexes().size() / 3);
+  std::vector<int> broken = clean;
+  broken.insert(broken.end(), {0, 1, vertexCount + 100000, -5, 0, 1});
+
+  s21::ThreadPool pool(4);
+  std::size_t target = clean.size() / 3 / 4;
+  s21::MeshLod expected =
+      s21::MeshSimplifier::simplify(model.getVertexes(), clean, target, pool);
+  s21::MeshLod lod =
+      s21::MeshSimplifier::simplify(model.getVertexes(), broken, target, pool);
+  EXPECT_EQ(lod.triangles, expected.triangles);
+  EXPECT_EQ(lod.vertexes, expected.vertexes);
+}
+
+TEST(MeshSimplifierTest, ChainIsDeterministicAcrossThreads) {
+  using s21::MeshGenerator;
+  // Достаточно треугольников, чтобы сетка делилась на участки.
+  s21::Model model = s21::Model::fromText(
+      MeshGenerator::generate(MeshGenerator::kSphere, 40000, 3));
+  const std::vector<float> ratios = s21::MeshSimplifier::defaultRatios();
+  s21::ThreadPool single(1), several(4);
+  std::vector<s21::MeshLod> first = s21::MeshSimplifier::buildChain(
+      model.getVertexes(), model.getEdges(), ratios, single);
+  std::vector<s21::MeshLod> second = s21::MeshSimplifier::buildChain(
+      model.getVertexes(), model.getEdges(), ratios, several);
+
+  ASSERT_EQ(first.size(), ratios.size());
+  std::size_t triangles = model.getEdges().size() / 3;
+  EXPECT_GT(triangles, 32768u);
+  std::size_t previous = triangles;
+  for (std::size_t level = 0; level < first.size(); level++) {
+    std::size_t count = first[level].triangles.size() / 3;
+    EXPECT_LT(count, previous);
+    EXPECT_LE(count, triangles * ratios[level] * 1.1 + 4);
+    EXPECT_EQ(first[level].triangles, second[level].triangles);
+    EXPECT_EQ(first[level].vertexes, second[level].vertexes);
+    EXPECT_FLOAT_EQ(first[level].ratio, ratios[level]);
+    EXPECT_LT(first[level].error, model.getRadius());
+    if (level > 0) {
+      EXPECT_GE(first[level].error, first[level - 1].error);
+    }
+    previous = count;
+  }
+
+  s21::LoadProgress cancelled;
+  cancelled.cancel();
+  EXPECT_THROW(s21::MeshSimplifier::buildChain(model.getVertexes(),
+                                               model.getEdges(), ratios,
+                                               single, &cancelled),
+               s21::LoadCancelled);
+}
+
+TEST(LodSelectorTest, ZoomSwitchesLevelsWithHysteresis) {
+  s21::LodSelector selector;
+  selector.setLevels({0.0f, 0.01f, 0.04f, 0.2f});
+  EXPECT_EQ(selector.levelCount(), 4u);
+  // Крупная модель на экране: ошибка даже первого уровня заметна.
+  EXPECT_EQ(selector.select(1000.0f), 0u);
+  // При отдалении выбирается самый грубый уровень в пределах допуска.
+  EXPECT_EQ(selector.select(20.0f), 2u);
+  EXPECT_EQ(selector.select(2.0f), 3u);
+  // Колебания масштаба около границы уровней не переключают их.
+  EXPECT_EQ(selector.select(20.0f), 2u);
+  for (float scale : {24.0f, 27.0f, 22.0f, 29.0f}) {
+    EXPECT_EQ(selector.select(scale), 2u);
+  }
+  // Приближение за полосу гистерезиса возвращает подробный уровень.
+  EXPECT_EQ(selector.select(40.0f), 1u);
+  EXPECT_EQ(selector.select(500.0f), 0u);
+}
+
+TEST(LodSelectorTest, SlowFramesRaiseTolerance) {
+  s21::LodSelector selector;
+  selector.setLevels({0.0f, 0.01f, 0.04f});
+  selector.setTargetFrameTime(16.0);
+  EXPECT_EQ(selector.select(150.0f), 0u);
+  for (int frame = 0; frame < 20; frame++) selector.reportFrameTime(40.0);
+  EXPECT_FLOAT_EQ(selector.getToleranceScale(),
+                  s21::LodSelector::kMaxToleranceScale);
+  EXPECT_EQ(selector.select(150.0f), 2u);
+  for (int frame = 0; frame < 20; frame++) selector.reportFrameTime(5.0);
+  EXPECT_FLOAT_EQ(selector.getToleranceScale(), 1.0f);
+  EXPECT_EQ(selector.select(150.0f), 0u);
+}
+
+TEST(LodSelectorTest, InteractionDrawsAffordableLevel) {
+  s21::LodSelector selector;
+  selector.setLevels({0.0f, 0.01f, 0.04f, 0.2f}, {8000, 4000, 1600, 160});
+  EXPECT_EQ(selector.select(1000.0f), 0u);
+  selector.setInteractive(true, 2000);
+  EXPECT_EQ(selector.select(1000.0f), 2u);
+  // Экранный размер по-прежнему может выбрать уровень грубее бюджетного.
+  EXPECT_EQ(selector.select(2.0f), 3u);
+  selector.setInteractive(true, 10);
+  EXPECT_EQ(selector.select(1000.0f), 3u);
+  selector.setInteractive(false, 10);
+  EXPECT_EQ(selector.select(1000.0f), 0u);
+
+  std::vector<int> lines{};
+  for (int i = 0; i < 1000; i++) lines.insert(lines.end(), {i, i + 1});
+  std::vector<int> sampled = s21::LodSelector::strideLines(lines, 300);
+  EXPECT_LE(sampled.size(), 300u);
+  EXPECT_GE(sampled.size(), 200u);
+  for (std::size_t i = 0; i < sampled.size(); i += 2)
+    EXPECT_EQ(sampled[i + 1], sampled[i] + 1);
+  EXPECT_EQ(s21::LodSelector::strideLines(lines, 5000), lines);
+}
+
+TEST(LodSelectorTest, ProjectedRadius) {
+  const float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+  const float center[3] = {0.2f, -0.1f, 0.0f};
+  EXPECT_FLOAT_EQ(s21::LodSelector::projectedRadius(identity, center, 0.5f,
+                                                    200),
+                  50.0f);
+  // Перспектива: вдвое дальше - вдвое меньше.
+  const float perspective[16] = {1, 0, 0, 0, 0, 1, 0, 0,
+                                 0, 0, 1, 0, 0, 0, -1, 0};
+  const float near[3] = {0.0f, 0.0f, -2.0f};
+  const float far[3] = {0.0f, 0.0f, -4.0f};
+  float nearRadius =
+      s21::LodSelector::projectedRadius(perspective, near, 0.1f, 400);
+  float farRadius =
+      s21::LodSelector::projectedRadius(perspective, far, 0.1f, 400);
+  EXPECT_NEAR(nearRadius / farRadius, 2.0f, 0.1f);
+  const float behind[3] = {0.0f, 0.0f, 3.0f};
+  EXPECT_TRUE(std::isinf(
+      s21::LodSelector::projectedRadius(perspective, behind, 0.1f, 400)));
+}
+
+TEST(NumberParserTest, ParseFloat) {
+  const char *samples[] = {"0",       "-1.25",    "+3.5",     ".5",
+                           "1e3",     "-2.5E-3",  "123.456",  "0.000001",
+                           "7.",      "1e-40",    "3.4e38",   "0.1234567"};
+  for (const char *sample : samples) {
+    const char *cursor = sample;
+    const char *end = sample + std::strlen(sample);
+    float value{};
+    ASSERT_TRUE(s21::NumberParser::parseFloat(cursor, end, value)) << sample;
+    EXPECT_EQ(cursor, end) << sample;
+    EXPECT_FLOAT_EQ(value, std::strtof(sample, nullptr)) << sample;
+  }
+
+  const char *text = "12.5/7";
+  const char *cursor = text;
+  float value{};
+  ASSERT_TRUE(s21::NumberParser::parseFloat(cursor, text + 6, value));
+  EXPECT_FLOAT_EQ(value, 12.5f);
+  EXPECT_EQ(*cursor, '/');
+
+  const char *bad = "-x";
+  cursor = bad;
+  EXPECT_FALSE(s21::NumberParser::parseFloat(cursor, bad + 2, value));
+  EXPECT_EQ(cursor, bad);
+}
+
+TEST(NumberParserTest, ParseInt) {
+  const char *text = "42/-7 x";
+  const char *cursor = text;
+  const char *end = text + 7;
+  int value{};
+  ASSERT_TRUE(s21::NumberParser::parseInt(cursor, end, value));
+  EXPECT_EQ(value, 42);
+  cursor++;
+  ASSERT_TRUE(s21::NumberParser::parseInt(cursor, end, value));
+  EXPECT_EQ(value, -7);
+  cursor++;
+  EXPECT_FALSE(s21::NumberParser::parseInt(cursor, end, value));
+}
+
+TEST(CharScannerTest, MasksMatchScalar) {
+  std::string text{};
+  unsigned seed = 12345;
+  const char alphabet[] = "f 12/3/4\t-0.5e\n/ v";
+  for (int i = 0; i < 64 * 16; i++) {
+    seed = seed * 1103515245 + 12345;
+    text.push_back(alphabet[(seed >> 16) % (sizeof(alphabet) - 1)]);
+  }
+
+  for (auto isa : {s21::CharScanner::kSse2, s21::CharScanner::kAvx2}) {
+    if (!s21::CharScanner::supported(isa)) continue;
+    for (std::size_t offset = 0; offset + 64 <= text.size(); offset += 7) {
+      auto expected = s21::CharScanner::scan(text.data() + offset, 64,
+                                             s21::CharScanner::kScalar);
+      auto actual = s21::CharScanner::scan(text.data() + offset, 64, isa);
+      ASSERT_EQ(actual.newline, expected.newline) << isa << " " << offset;
+      ASSERT_EQ(actual.space, expected.space) << isa << " " << offset;
+      ASSERT_EQ(actual.slash, expected.slash) << isa << " " << offset;
+    }
+  }
+}
+
+TEST(CharScannerTest, NextCrossesBlocks) {
+  std::string text(150, 'x');
+  text[3] = ' ';
+  text[70] = '/';
+  text[140] = '\n';
+  s21::CharScanner scanner(text.data(), text.data() + text.size());
+  const char *begin = text.data();
+
+  EXPECT_EQ(scanner.next(begin, s21::CharScanner::kSpace) - begin, 3);
+  EXPECT_EQ(scanner.next(begin + 4, s21::CharScanner::kSlash) - begin, 70);
+  EXPECT_EQ(scanner.next(begin + 4, s21::CharScanner::kNewline) - begin, 140);
+  EXPECT_EQ(scanner.next(begin + 141, s21::CharScanner::kNewline) - begin,
+            150);
+  EXPECT_EQ(scanner.next(begin + 4, s21::CharScanner::kSpace) - begin, 150);
+  EXPECT_EQ(scanner.next(begin + 4, s21::CharScanner::kSlash, begin + 70) -
+                begin,
+            70);
+  EXPECT_EQ(scanner.next(begin + 4, s21::CharScanner::kSlash, begin + 71) -
+                begin,
+            70);
+  EXPECT_EQ(
+      scanner.next(begin + 4, s21::CharScanner::kNewline, begin + 64) - begin,
+      64);
+}
+
+TEST(EdgeExtractorTest, SharedEdgesAppearOnce) {
+  std::vector<int> outlines = {0, 1, 2, -1, 2, 1, 3, -1, 4,
+                               4, 5, -1, 6, -1, 7, 8};
+  s21::ThreadPool pool(2);
+  std::vector<int> lines = s21::EdgeExtractor::extract(outlines, pool);
+  std::vector<int> expected = {0, 1, 0, 2, 1, 2, 1, 3, 2, 3, 4, 5, 7, 8};
+  EXPECT_EQ(lines, expected);
+  EXPECT_TRUE(s21::EdgeExtractor::extract({}, pool).empty());
+}
+
+TEST(EdgeExtractorTest, RadixSortMatchesStdSort) {
+  std::mt19937_64 random(21);
+  std::vector<std::uint64_t> keys(300000);
+  for (auto &key : keys) key = random() & ((std::uint64_t{1} << 42) - 1);
+  std::vector<std::uint64_t> expected = keys;
+  std::sort(expected.begin(), expected.end());
+
+  s21::ThreadPool pool(3);
+  s21::EdgeExtractor::radixSort(keys, 42, pool);
+  EXPECT_TRUE(keys == expected);
+}
+
+TEST(EdgeExtractorTest, GridHasEachEdgeOnce) {
+  // Сетка side x side из квадратов: горизонтальных и вертикальных рёбер
+  // по side * (side + 1), каждое общее ребро соседних квадратов - один раз.
+  const int side = 300;
+  std::vector<int> outlines{};
+  for (int y = 0; y < side; y++) {
+    for (int x = 0; x < side; x++) {
+      int v = y * (side + 1) + x;
+      int right = v + 1, up = v + side + 1, corner = up + 1;
+      outlines.insert(outlines.end(), {v, right, corner, up, -1});
+    }
+  }
+  s21::ThreadPool pool(3);
+  std::vector<int> lines = s21::EdgeExtractor::extract(outlines, pool);
+  EXPECT_EQ((int)lines.size() / 2, 2 * side * (side + 1));
+}
+
+namespace {
+float TriangleArea(const std::vector<float> &vertexes, const int *corner) {
+  const float *a = vertexes.data() + corner[0] * 3;
+  const float *b = vertexes.data() + corner[1] * 3;
+  const float *c = vertexes.data() + corner[2] * 3;
+  return std::fabs((b[0] - a[0]) * (c[1] - a[1]) -
+                   (b[1] - a[1]) * (c[0] - a[0])) /
+         2.0f;
+}
+}  // namespace
+
+TEST(TriangulatorTest, ConcavePolygonIsEarClipped) {
+  // Буква "L" в плоскости z = 0, обход по часовой стрелке; площадь 3.
+  // Веер из вершины 1 вышел бы за пределы многоугольника.
+  std::vector<float> vertexes = {0, 0, 0, 0, 2, 0, 1, 2, 0,
+                                 1, 1, 0, 2, 1, 0, 2, 0, 0};
+  std::vector<int> polygon = {0, 1, 2, 3, 4, 5};
+  for (int shift = 0; shift < 6; shift++) {
+    std::rotate(polygon.begin(), polygon.begin() + 1, polygon.end());
+    std::vector<int> triangles(12);
+    s21::Triangulator::triangulatePolygon(polygon.data(), polygon.size(),
+                                          vertexes, triangles.data());
+    float area = 0.0f;
+    for (int t = 0; t < 4; t++)
+      area += TriangleArea(vertexes, triangles.data() + t * 3);
+    EXPECT_FLOAT_EQ(area, 3.0f);
+  }
+}
+
+TEST(TriangulatorTest, FacesAreTriangulatedInOrder) {
+  std::vector<float> vertexes = {0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0};
+  std::vector<int> outlines{};
+  const int faces = 50000;
+  for (int i = 0; i < faces; i++) {
+    if (i % 2 == 0)
+      outlines.insert(outlines.end(), {0, 1, 2, 3, -1});
+    else
+      outlines.insert(outlines.end(), {3, 2, 1, -1});
+  }
+  outlines.insert(outlines.end(), {0, 1, -1});
+
+  s21::ThreadPool pool(3);
+  std::vector<int> triangles =
+      s21::Triangulator::triangulate(outlines, vertexes, pool);
+  ASSERT_EQ((int)triangles.size(), faces / 2 * 9);
+  std::vector<int> quad = {0, 1, 2, 0, 2, 3};
+  std::vector<int> triangle = {3, 2, 1};
+  for (int i = 0; i < faces; i += 2) {
+    const int *face = triangles.data() + i / 2 * 9;
+    EXPECT_TRUE(std::equal(quad.begin(), quad.end(), face));
+    EXPECT_TRUE(std::equal(triangle.begin(), triangle.end(), face + 6));
+  }
+}
+
+TEST(ModelLoaderTest, LoadsInBackground) {
   CreateTestObjFile();
+  s21::ModelLoader loader("test.obj");
+  std::shared_ptr<s21::Controller> controller = loader.takeResult();
+
+  EXPECT_TRUE(loader.isFinished());
+  EXPECT_DOUBLE_EQ(loader.getProgress(), 1.0);
+  ASSERT_NE(controller, nullptr);
+  EXPECT_EQ((int)controller->getVertexCount(), 8);
+  EXPECT_EQ((int)controller->getFacetsCount(), 6);
+  DeleteTestObjFile();
+}
+
+TEST(ModelLoaderTest, CancelStopsLoading) {
+  {
+    std::ofstream file("test_cancel.obj");
+    for (int i = 0; i < 300000; i++) {
+      file << "v " << i << " " << i << " " << i << "\n";
+    }
+  }
+  s21::ModelLoader loader("test_cancel.obj");
+  loader.cancel();
+
+  EXPECT_THROW(loader.takeResult(), s21::LoadCancelled);
+  EXPECT_TRUE(loader.isFinished());
+  std::remove("test_cancel.obj");
+}
 
-  s21::Controller shape("test.obj");
+TEST(ModelLoaderTest, ReportsParseError) {
+  s21::ModelLoader loader("missing_file.obj");
+  EXPECT_THROW(loader.takeResult(), std::invalid_argument);
+}
+
+TEST(CameraTest, ModelMatrixCalculation) {
+  s21::Controller shape = s21::Controller::fromText(kCubeObj);
   s21::Camera camera;
   camera.calculateModelMatrix(&shape);
 
@@ -110,8 +960,49 @@ TEST(CameraTest, ModelMatrixCalculation) {
   for (int i = 0; i < 16; i++) {
     EXPECT_FLOAT_EQ(camera.getModelMatrix()[i], expectedModelMatrix[i]);
   }
+}
 
-  DeleteTestObjFile();
+TEST(CameraTest, ModelMatrixCentersOffsetModel) {
+  // Модель целиком в отрицательной части пространства.
+  s21::Controller shape = s21::Controller::fromText(
+      "v -10 -4 -9\nv -6 -2 -1\nv -8 -3 -5\nf 1 2 3\n");
+  s21::Camera camera;
+  camera.calculateModelMatrix(&shape);
+  s21::Mat4f model;
+  std::copy(camera.getModelMatrix(), camera.getModelMatrix() + 16, model.m);
+  // Наибольшая сторона 8 вписывается в 1.2.
+  EXPECT_FLOAT_EQ(model[0], 0.15f);
+  s21::Vec4f center = model * s21::Vec4f{-8.0f, -3.0f, -5.0f, 1.0f};
+  EXPECT_NEAR(center.x, 0.0f, 1e-6);
+  EXPECT_NEAR(center.y, 0.0f, 1e-6);
+  EXPECT_NEAR(center.z, -0.15f, 1e-6);
+
+  // Позиция и масштаб задаются для центра модели.
+  camera.setModelScale(0.5f);
+  camera.setModelPosition(1.0f, 2.0f, 3.0f);
+  camera.scaleModel(2.0f);
+  std::copy(camera.getModelMatrix(), camera.getModelMatrix() + 16, model.m);
+  center = model * s21::Vec4f{-8.0f, -3.0f, -5.0f, 1.0f};
+  EXPECT_NEAR(center.x, 1.0f, 1e-5);
+  EXPECT_NEAR(center.y, 2.0f, 1e-5);
+  EXPECT_NEAR(center.z, 3.0f, 1e-5);
+  EXPECT_FLOAT_EQ(model[0], 1.0f);
+}
+
+TEST(CameraTest, PannedPositionRoundTrips) {
+  s21::Camera camera;
+  camera.calculateModelMatrix(s21::Vec3f{-10.0f, -4.0f, -9.0f},
+                              s21::Vec3f{-6.0f, -2.0f, -1.0f});
+  camera.setModelScale(0.3f);
+  camera.translateModel(0.25f, -0.5f);
+  s21::Mat4f panned;
+  std::copy(camera.getModelMatrix(), camera.getModelMatrix() + 16, panned.m);
+
+  // Ползунок передаёт прочитанную позицию обратно без изменений.
+  s21::Vec3f position = camera.getModelPosition();
+  camera.setModelPosition(position.x, position.y, position.z);
+  for (int i = 0; i < 16; ++i)
+    EXPECT_NEAR(camera.getModelMatrix()[i], panned[i], 1e-6) << i;
 }
 
 TEST(CameraTest, SetModelPositionWithTestFile) {
@@ -174,26 +1065,23 @@ TEST(CameraTest, ViewMatrixCalculation) {
 }
 
 TEST(CameraTest, MultModelRotation) {
-  CreateTestObjFile();
-  s21::Controller shape("test.obj");
+  s21::Controller shape = s21::Controller::fromText(kCubeObj);
   s21::Camera camera;
   camera.calculateModelMatrix(&shape);
   camera.calculateViewMatrix();
   camera.calculateRotationMatrix(45.0f, 30.0f, 60.0f);
   camera.multModelRotation();
 
-  float expected[16] = {0.0760,  -0.556, -0.2121, 0,       0.3674, 0.2121,
-                        -0.4242, 0,      0.3562,  -0.0943, 0.2613, -0.6,
-                        0,       0,      0,       1};
+  float expected[16] = {0.0761,  -0.5561, -0.2121, 0,       0.3674, 0.2121,
+                        -0.4243, 0,       0.4682,  -0.0761, 0.3674, -0.6,
+                        0,       0,       0,       1};
   for (auto i = 0; i < 16; i++) {
     EXPECT_NEAR(expected[i], camera.getMvpMatrix()[i], 0.01);
   }
-  DeleteTestObjFile();
 }
 
 TEST(CameraTest, MultMvpView) {
-  CreateTestObjFile();
-  s21::Controller shape("test.obj");
+  s21::Controller shape = s21::Controller::fromText(kCubeObj);
   s21::Camera camera;
   camera.calculateModelMatrix(&shape);
   camera.calculateViewMatrix();
@@ -201,19 +1089,17 @@ TEST(CameraTest, MultMvpView) {
   camera.multModelRotation();
   camera.multMvpView();
 
-  float expected[16] = {-0.0538079, -0.393198,  0.212132,  0.212132,
-                        -0.259808,  0.15,       0.424264,  0.424264,
-                        -0.251904,  -0.0666952, -0.261357, -0.861357,
-                        0,          0,          0,         1};
+  float expected[16] = {-0.0538, -0.3932, 0.2121,  -0.2121,
+                        -0.2598, 0.15,    0.4243,  -0.4243,
+                        -0.3311, -0.0538, -0.3674, -0.2326,
+                        0,       0,       0,       1};
   for (auto i = 0; i < 16; i++) {
     EXPECT_NEAR(expected[i], camera.getMvpMatrix()[i], 0.01);
   }
-  DeleteTestObjFile();
 }
 
 TEST(CameraTest, MultMvpProjection) {
-  CreateTestObjFile();
-  s21::Controller shape("test.obj");
+  s21::Controller shape = s21::Controller::fromText(kCubeObj);
   s21::Camera camera;
   camera.calculateModelMatrix(&shape);
   camera.calculateViewMatrix();
@@ -222,12 +1108,190 @@ TEST(CameraTest, MultMvpProjection) {
   camera.s21Frustum(1.0f, 45.0f, 0.1f, 100.0f);
   camera.multMvpProjection();
 
-  float expected[16] = {0.183712, -1.34246,  0.212557,  -0.212557,
-                        0.887039, 0.512132,  0.425113,  -0.425113,
-                        0.860054, -0.227712, -0.141761, -0.458239,
-                        0,        0,         -0.2002,   1.2002};
+  float expected[16] = {0.1837, -1.3425, 0.2126,  0.2121,
+                        0.887,  0.5121,  0.4251,  0.4243,
+                        1.1303, -0.1837, -0.248,  -0.9674,
+                        0,      0,       -0.2002, 1};
   for (auto i = 0; i < 16; i++) {
     EXPECT_NEAR(expected[i], camera.getMvpMatrix()[i], 0.01);
   }
-  DeleteTestObjFile();
+}
+
+TEST(CameraTest, UpdateMvpFollowsChangedMatrices) {
+  s21::Controller shape = s21::Controller::fromText(kCubeObj);
+  s21::Camera camera;
+  camera.calculateModelMatrix(&shape);
+  camera.calculateViewMatrix();
+  camera.s21Frustum(1.0f, 45.0f, 0.1f, 100.0f);
+  camera.calculateRotationMatrix(45.0f, 30.0f, 60.0f);
+  auto expectStepwise = [&camera]() {
+    float cached[16];
+    std::copy(camera.updateMvp(), camera.updateMvp() + 16, cached);
+    camera.multModelRotation();
+    camera.multMvpView();
+    camera.multMvpProjection();
+    for (int i = 0; i < 16; i++)
+      EXPECT_NEAR(cached[i], camera.getMvpMatrix()[i], 1e-5);
+  };
+  expectStepwise();
+  camera.setModelPosition(0.5f, -0.25f, 1.0f);
+  expectStepwise();
+  camera.s21Ortho(2.0f, 60.0f, 0.01f, 100.0f);
+  expectStepwise();
+  camera.setModelScale(2.0f);
+  camera.calculateRotationMatrix(10.0f, 20.0f, 30.0f);
+  expectStepwise();
+}
+
+TEST(CameraTest, TransformPointsMatchesMatrixProduct) {
+  s21::Controller shape = s21::Controller::fromText(kCubeObj);
+  s21::Camera camera;
+  camera.calculateModelMatrix(&shape);
+  camera.calculateViewMatrix();
+  camera.s21Frustum(1.0f, 45.0f, 0.1f, 100.0f);
+  camera.calculateRotationMatrix(45.0f, 30.0f, 60.0f);
+  camera.setModelPosition(0.5f, -0.25f, 1.0f);
+  // Два блока пула и хвост, не кратный восьми точкам.
+  const std::size_t count = (std::size_t{1} << 17) + 13;
+  std::vector<float> points(count * 3);
+  for (std::size_t i = 0; i < points.size(); i++)
+    points[i] = static_cast<float>(i % 101) * 0.01f - 0.5f;
+  s21::ThreadPool pool(3);
+  for (s21::Camera::Space space : {s21::Camera::kModel, s21::Camera::kDevice}) {
+    s21::Mat4f matrix;
+    std::copy(camera.updateMvp(), camera.updateMvp() + 16, matrix.m);
+    if (space == s21::Camera::kModel) {
+      s21::Mat4f model, rotation;
+      std::copy(camera.getModelMatrix(), camera.getModelMatrix() + 16, model.m);
+      std::copy(camera.getRotataionMatrix(),
+                camera.getRotataionMatrix() + 16, rotation.m);
+      matrix = model * rotation;
+    }
+    std::vector<float> out(points.size()), small(points.begin(),
+                                                 points.begin() + 13 * 3);
+    camera.transformPoints(points.data(), out.data(), count, space, pool);
+    camera.transformPoints(small.data(), small.data(), 13, space, pool);
+    for (std::size_t i = 0; i < count; i++) {
+      s21::Vec4f p = matrix * s21::Vec4f{points[i * 3], points[i * 3 + 1],
+                                         points[i * 3 + 2], 1.0f};
+      if (space == s21::Camera::kDevice) p = p * (1.0f / p.w);
+      const float expected[3] = {p.x, p.y, p.z};
+      for (int axis = 0; axis < 3; axis++) {
+        float tolerance = 1e-5f * (1.0f + std::fabs(expected[axis]));
+        ASSERT_NEAR(expected[axis], out[i * 3 + axis], tolerance);
+        if (i < 13) {
+          ASSERT_EQ(out[i * 3 + axis], small[i * 3 + axis]);
+        }
+      }
+    }
+  }
+}
+
+TEST(CameraTest, QuaternionMatchesEulerRotation) {
+  s21::Camera euler, quaternion;
+  euler.calculateRotationMatrix(45.0f, 30.0f, 60.0f);
+  quaternion.setRotation(s21::Camera::eulerRotation(45.0f, 30.0f, 60.0f));
+  for (int i = 0; i < 16; i++)
+    EXPECT_NEAR(euler.getRotataionMatrix()[i],
+                quaternion.getRotataionMatrix()[i], 1e-5);
+}
+
+TEST(CameraTest, OrbitKeepsPointUnderCursor) {
+  s21::CameraController &camera = s21::CameraController::getInstance();
+  camera.calculateRotationMatrix(0.0f, 0.0f, 0.0f);
+  camera.beginOrbit(0.0f, 0.0f);
+  camera.orbit(0.2f, 0.1f);
+  camera.orbit(0.3f, -0.2f);
+  s21::Mat4f rotation;
+  std::copy(camera.getRotataionMatrix(), camera.getRotataionMatrix() + 16,
+            rotation.m);
+  s21::Vec4f moved = rotation * s21::Camera::arcballPoint(0.0f, 0.0f);
+  s21::Vec4f cursor = s21::Camera::arcballPoint(0.3f, -0.2f);
+  EXPECT_NEAR(moved.x, cursor.x, 1e-4);
+  EXPECT_NEAR(moved.y, cursor.y, 1e-4);
+  EXPECT_NEAR(moved.z, cursor.z, 1e-4);
+
+  camera.setModelPosition(0.0f, 0.0f, 0.0f);
+  camera.setModelScale(1.0f);
+  camera.pan(0.25f, -0.5f);
+  camera.zoom(2.0f);
+  EXPECT_FLOAT_EQ(camera.getModelMatrix()[3], 0.25f);
+  EXPECT_FLOAT_EQ(camera.getModelMatrix()[7], -0.5f);
+  EXPECT_FLOAT_EQ(camera.getModelMatrix()[0], 2.0f);
+  camera.calculateRotationMatrix(0.0f, 0.0f, 0.0f);
+}
+
+TEST(CameraTest, Mat4MultiplyMatchesScalarAndAllowsAliasing) {
+  static_assert(alignof(s21::Mat4f) == 16, "s21::Mat4f must fit SSE registers");
+  s21::Mat4f a{}, b{};
+  for (int i = 0; i < 16; i++) {
+    a[i] = 0.25f * i - 1.0f;
+    b[i] = 1.0f / (i + 1);
+  }
+  float expected[16];
+  for (int row = 0; row < 4; row++) {
+    for (int col = 0; col < 4; col++) {
+      float sum = 0.0f;
+      for (int i = 0; i < 4; i++) sum += a[row * 4 + i] * b[i * 4 + col];
+      expected[row * 4 + col] = sum;
+    }
+  }
+  s21::Mat4f product = a * b;
+  for (int i = 0; i < 16; i++) EXPECT_NEAR(product[i], expected[i], 1e-5);
+  s21::Camera::multiply(a.m, b.m, a.m);
+  for (int i = 0; i < 16; i++) EXPECT_NEAR(a[i], expected[i], 1e-5);
+  s21::Mat4f identity = s21::Mat4f::identity();
+  product = product * identity;
+  for (int i = 0; i < 16; i++) EXPECT_NEAR(product[i], expected[i], 1e-5);
+}
+
+TEST(CameraTest, Mat4TransformsVector) {
+  s21::Mat4f matrix = s21::Mat4f::identity();
+  matrix[3] = 1.0f;
+  matrix[7] = -2.0f;
+  matrix[10] = 3.0f;
+  s21::Vec4f point = matrix * s21::Vec4f{1.0f, 2.0f, 3.0f, 1.0f};
+  EXPECT_FLOAT_EQ(point.x, 2.0f);
+  EXPECT_FLOAT_EQ(point.y, 0.0f);
+  EXPECT_FLOAT_EQ(point.z, 9.0f);
+  EXPECT_FLOAT_EQ(point.w, 1.0f);
+}
+
+TEST(LinearAlgebraTest, CompileTimeIdentities) {
+  using s21::Mat4d;
+  using s21::Vec3d;
+  using s21::Vec4d;
+  constexpr Mat4d identity = Mat4d::identity();
+  constexpr Mat4d moved = s21::translation(Vec3d{1.0, -2.0, 3.0});
+  static_assert(identity * identity == identity);
+  static_assert(moved * identity == moved && identity * moved == moved);
+  static_assert(s21::transpose(s21::transpose(moved)) == moved);
+  static_assert(moved * s21::translation(Vec3d{-1.0, 2.0, -3.0}) == identity);
+  static_assert(moved * Vec4d{1.0, 1.0, 1.0, 1.0} ==
+                Vec4d{2.0, -1.0, 4.0, 1.0});
+  static_assert(s21::cross(Vec3d{1, 0, 0}, Vec3d{0, 1, 0}) == Vec3d{0, 0, 1});
+  static_assert(s21::squareRoot(16.0) == 4.0);
+  static_assert(s21::squareRoot(2.0f) == 1.41421356f);
+  static_assert(s21::length(Vec3d{3, 4, 12}) == 13.0);
+
+  // Проекция переводит точки ближней плоскости в z = -1, дальней в z = 1.
+  constexpr Mat4d perspective =
+      s21::frustum(-1.0, 1.0, -1.0, 1.0, 1.0, 10.0);
+  constexpr Vec4d nearCorner = perspective * Vec4d{1.0, 1.0, -1.0, 1.0};
+  static_assert(nearCorner == Vec4d{1.0, 1.0, -1.0, 1.0});
+  constexpr Vec4d farPoint = perspective * Vec4d{0.0, 0.0, -10.0, 1.0};
+  static_assert(farPoint.z == farPoint.w);
+  constexpr Mat4d box = s21::ortho(-2.0, 2.0, -1.0, 1.0, 0.0, 4.0);
+  static_assert(box * Vec4d{2.0, -1.0, -4.0, 1.0} ==
+                Vec4d{1.0, -1.0, 1.0, 1.0});
+
+  // Матрица вида собирается при компиляции из тех же функций, что
+  // и раньше во время выполнения.
+  constexpr s21::Mat4f view = s21::Camera::viewMatrix();
+  static_assert(view[10] == -1.0f && view[11] == 1.0f && view[15] == 1.0f);
+  static_assert(view[0] == -view[5]);
+  s21::Camera camera;
+  camera.calculateViewMatrix();
+  for (int i = 0; i < 16; i++) EXPECT_EQ(camera.getViewMatrix()[i], view[i]);
+  EXPECT_FLOAT_EQ(view[5], std::sqrt(0.5f));
 }
\ No newline at end of file
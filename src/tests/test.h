@@ -5,10 +5,28 @@
 #ifndef VIEWER_FRONT_SRC_TESTS_TEST_H_
 #define VIEWER_FRONT_SRC_TESTS_TEST_H_
 #include <gtest/gtest.h>
+#include <sys/stat.h>
 #include <unistd.h>
+#include <zlib.h>
 
 #include "../model/obj_model.h"
+#include "../model/bounding_box.h"
 #include "../model/camera_model.h"
+#include "../model/char_scanner.h"
+#include "../model/decompressor.h"
+#include "../model/edge_extractor.h"
+#include "../model/linear_algebra.h"
+#include "../model/mesh_cache.h"
+#include "../model/mesh_stream.h"
+#include "../model/mesh_simplifier.h"
+#include "../model/number_parser.h"
+#include "../model/thread_pool.h"
+#include "../model/triangulator.h"
+#include "../model/vertex_welder.h"
 #include "../controller/obj_controller.h"
 #include "../controller/camera_controller.h"
+#include "../controller/model_loader.h"
+#include "../controller/lod_builder.h"
+#include "../controller/lod_selector.h"
+#include "../tools/mesh_generator.h"
 #endif // VIEWER_FRONT_SRC_TESTS_TEST_H_
@@ -0,0 +1,29 @@
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "mesh_generator.h"
+
+// Пишет синтетическую модель:
+//   generate_mesh <sphere|terrain|soup|cloud> <faces> <seed> <file.obj>
+int main(int argc, char **argv) {
+  if (argc != 5) {
+    std::cerr << "usage: " << argv[0]
+              << " <sphere|terrain|soup|cloud> <faces> <seed> <file.obj>\n";
+    return 2;
+  }
+  try {
+    s21::MeshGenerator::Shape shape = s21::MeshGenerator::parseShape(argv[1]);
+    std::uint64_t faces = std::stoull(argv[2]);
+    std::uint64_t seed = std::stoull(argv[3]);
+    s21::MeshGenerator::Size size =
+        s21::MeshGenerator::writeFile(argv[4], shape, faces, seed);
+    std::cout << argv[4] << ": " << size.vertexes << " vertexes, "
+              << size.faces << " faces\n";
+  } catch (const std::exception &error) {
+    std::cerr << error.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
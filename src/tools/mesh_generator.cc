@@ -0,0 +1,336 @@
+#include "mesh_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+
+namespace s21 {
+namespace {
+/// Размер буфера, по заполнении которого текст сбрасывается в поток.
+constexpr std::size_t kFlushSize = std::size_t{1} << 20;
+constexpr double kPi = 3.14159265358979323846;
+
+/**
+ * @brief Генератор SplitMix64: переносимый, в отличие от распределений
+ * стандартной библиотеки, результат которых зависит от реализации.
+ */
+class Random {
+ public:
+  explicit Random(std::uint64_t seed) : state_{seed} {}
+
+  std::uint64_t next() {
+    std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  /// Равномерное число из [0, 1).
+  double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+  /// Равномерное число из [-1, 1).
+  double signedUniform() { return uniform() * 2.0 - 1.0; }
+
+ private:
+  std::uint64_t state_;
+};
+
+/**
+ * @brief Буферизованная запись строк OBJ без локали и printf.
+ *
+ * Координаты пишутся с фиксированными шестью знаками после точки, чтобы
+ * текст не зависел от платформы.
+ */
+class ObjWriter {
+ public:
+  explicit ObjWriter(std::ostream &out) : out_{out}, buffer_{} {
+    buffer_.reserve(kFlushSize + 256);
+  }
+  ~ObjWriter() { flush(); }
+
+  ObjWriter(const ObjWriter &) = delete;
+  ObjWriter &operator=(const ObjWriter &) = delete;
+
+  void comment(const std::string &text) {
+    buffer_ += "# ";
+    buffer_ += text;
+    buffer_ += '\n';
+  }
+
+  void vertex(double x, double y, double z) {
+    buffer_ += 'v';
+    number(x);
+    number(y);
+    number(z);
+    buffer_ += '\n';
+    flushIfFull();
+  }
+
+  void face(std::initializer_list<std::uint64_t> indexes) {
+    buffer_ += 'f';
+    for (std::uint64_t index : indexes) {
+      buffer_ += ' ';
+      integer(index);
+    }
+    buffer_ += '\n';
+    flushIfFull();
+  }
+
+  void flush() {
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+
+ private:
+  void flushIfFull() {
+    if (buffer_.size() >= kFlushSize) flush();
+  }
+
+  void integer(std::uint64_t value) {
+    char digits[20];
+    int count = 0;
+    do {
+      digits[count++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value != 0);
+    while (count > 0) buffer_ += digits[--count];
+  }
+
+  void number(double value) {
+    buffer_ += ' ';
+    long long fixed = std::llround(value * 1e6);
+    if (fixed < 0) {
+      buffer_ += '-';
+      fixed = -fixed;
+    }
+    integer(static_cast<std::uint64_t>(fixed / 1000000));
+    buffer_ += '.';
+    long long fraction = fixed % 1000000;
+    for (long long scale = 100000; scale > 0; scale /= 10)
+      buffer_ += static_cast<char>('0' + fraction / scale % 10);
+  }
+
+  std::ostream &out_;
+  std::string buffer_;
+};
+
+/**
+ * @brief Значение решётки шума в узле (x, y) из [-1, 1).
+ */
+double latticeValue(std::int64_t x, std::int64_t y, std::uint64_t seed) {
+  Random random(seed ^ (static_cast<std::uint64_t>(x) * 0x8CB92BA72F3D8DD7ull) ^
+                (static_cast<std::uint64_t>(y) * 0xD6E8FEB86659FD93ull));
+  return random.signedUniform();
+}
+
+/**
+ * @brief Шум значений: сглаженная интерполяция случайных узлов решётки.
+ */
+double valueNoise(double x, double y, std::uint64_t seed) {
+  double fx = std::floor(x), fy = std::floor(y);
+  auto ix = static_cast<std::int64_t>(fx);
+  auto iy = static_cast<std::int64_t>(fy);
+  double tx = x - fx, ty = y - fy;
+  tx = tx * tx * (3.0 - 2.0 * tx);
+  ty = ty * ty * (3.0 - 2.0 * ty);
+  double top = latticeValue(ix, iy, seed) +
+               (latticeValue(ix + 1, iy, seed) - latticeValue(ix, iy, seed)) *
+                   tx;
+  double bottom =
+      latticeValue(ix, iy + 1, seed) +
+      (latticeValue(ix + 1, iy + 1, seed) - latticeValue(ix, iy + 1, seed)) *
+          tx;
+  return top + (bottom - top) * ty;
+}
+
+/**
+ * @brief Количество секторов сферы, дающее около faces треугольников.
+ */
+std::uint64_t sphereSlices(std::uint64_t faces) {
+  auto root = static_cast<std::uint64_t>(std::ceil(std::sqrt(faces)));
+  return std::max<std::uint64_t>(3, root);
+}
+
+/**
+ * @brief Количество вершин по стороне рельефа на около faces граней.
+ */
+std::uint64_t terrainSide(std::uint64_t faces) {
+  auto root = static_cast<std::uint64_t>(std::ceil(std::sqrt(faces)));
+  return std::max<std::uint64_t>(2, root + 1);
+}
+
+const char *shapeName(MeshGenerator::Shape shape) {
+  switch (shape) {
+    case MeshGenerator::kSphere:
+      return "sphere";
+    case MeshGenerator::kTerrain:
+      return "terrain";
+    case MeshGenerator::kSoup:
+      return "soup";
+    default:
+      return "cloud";
+  }
+}
+
+// Вершины сферы: полюс, пояса по slices вершин, второй полюс. Пояса
+// соединяются парами треугольников, полюса - веерами.
+void writeSphere(ObjWriter &writer, std::uint64_t faces, Random &random) {
+  std::uint64_t slices = sphereSlices(faces);
+  std::uint64_t stacks = slices / 2 + 1;
+  auto jitter = [&random] { return 1.0 + 0.01 * random.signedUniform(); };
+  writer.vertex(0.0, jitter(), 0.0);
+  for (std::uint64_t k = 1; k < stacks; k++) {
+    double phi = kPi * static_cast<double>(k) / static_cast<double>(stacks);
+    for (std::uint64_t j = 0; j < slices; j++) {
+      double theta =
+          2.0 * kPi * static_cast<double>(j) / static_cast<double>(slices);
+      double radius = jitter();
+      writer.vertex(radius * std::sin(phi) * std::cos(theta),
+                    radius * std::cos(phi),
+                    radius * std::sin(phi) * std::sin(theta));
+    }
+  }
+  writer.vertex(0.0, -jitter(), 0.0);
+
+  auto ring = [slices](std::uint64_t k, std::uint64_t j) {
+    return 2 + (k - 1) * slices + j % slices;
+  };
+  std::uint64_t bottom = 2 + (stacks - 1) * slices;
+  for (std::uint64_t j = 0; j < slices; j++)
+    writer.face({1, ring(1, j + 1), ring(1, j)});
+  for (std::uint64_t k = 1; k + 1 < stacks; k++) {
+    for (std::uint64_t j = 0; j < slices; j++) {
+      std::uint64_t a = ring(k, j), b = ring(k, j + 1);
+      std::uint64_t c = ring(k + 1, j + 1), d = ring(k + 1, j);
+      writer.face({a, b, c});
+      writer.face({a, c, d});
+    }
+  }
+  for (std::uint64_t j = 0; j < slices; j++)
+    writer.face({bottom, ring(stacks - 1, j), ring(stacks - 1, j + 1)});
+}
+
+void writeTerrain(ObjWriter &writer, std::uint64_t faces,
+                  std::uint64_t seed) {
+  std::uint64_t side = terrainSide(faces);
+  double step = 2.0 / static_cast<double>(side - 1);
+  for (std::uint64_t y = 0; y < side; y++) {
+    for (std::uint64_t x = 0; x < side; x++) {
+      double u = static_cast<double>(x) / static_cast<double>(side - 1);
+      double v = static_cast<double>(y) / static_cast<double>(side - 1);
+      double height = 0.0, amplitude = 0.25, frequency = 4.0;
+      for (std::uint64_t octave = 0; octave < 5; octave++) {
+        height += amplitude * valueNoise(u * frequency, v * frequency,
+                                         seed + octave);
+        amplitude *= 0.5;
+        frequency *= 2.0;
+      }
+      writer.vertex(static_cast<double>(x) * step - 1.0, height,
+                    static_cast<double>(y) * step - 1.0);
+    }
+  }
+  for (std::uint64_t y = 0; y + 1 < side; y++) {
+    for (std::uint64_t x = 0; x + 1 < side; x++) {
+      std::uint64_t a = y * side + x + 1;
+      writer.face({a, a + side, a + side + 1, a + 1});
+    }
+  }
+}
+
+void writeSoup(ObjWriter &writer, std::uint64_t faces, Random &random) {
+  double spread = 2.0 / std::cbrt(static_cast<double>(std::max<std::uint64_t>(
+                            faces, 1)));
+  for (std::uint64_t i = 0; i < faces; i++) {
+    double cx = random.signedUniform(), cy = random.signedUniform();
+    double cz = random.signedUniform();
+    for (int corner = 0; corner < 3; corner++) {
+      writer.vertex(cx + spread * random.signedUniform(),
+                    cy + spread * random.signedUniform(),
+                    cz + spread * random.signedUniform());
+    }
+  }
+  for (std::uint64_t i = 0; i < faces; i++)
+    writer.face({i * 3 + 1, i * 3 + 2, i * 3 + 3});
+}
+
+void writeCloud(ObjWriter &writer, std::uint64_t points, Random &random) {
+  for (std::uint64_t i = 0; i < points; i++) {
+    writer.vertex(random.signedUniform(), random.signedUniform(),
+                  random.signedUniform());
+  }
+}
+}  // namespace
+
+MeshGenerator::Size MeshGenerator::size(Shape shape, std::uint64_t faces) {
+  switch (shape) {
+    case kSphere: {
+      std::uint64_t slices = sphereSlices(faces);
+      std::uint64_t stacks = slices / 2 + 1;
+      return {slices * (stacks - 1) + 2, 2 * slices * (stacks - 1)};
+    }
+    case kTerrain: {
+      std::uint64_t side = terrainSide(faces);
+      return {side * side, (side - 1) * (side - 1)};
+    }
+    case kSoup:
+      return {faces * 3, faces};
+    default:
+      return {faces, 0};
+  }
+}
+
+MeshGenerator::Size MeshGenerator::write(std::ostream &out, Shape shape,
+                                         std::uint64_t faces,
+                                         std::uint64_t seed) {
+  Random random(seed);
+  {
+    ObjWriter writer(out);
+    writer.comment(std::string("s21 mesh generator: ") + shapeName(shape) +
+                   " faces=" + std::to_string(faces) +
+                   " seed=" + std::to_string(seed));
+    switch (shape) {
+      case kSphere:
+        writeSphere(writer, faces, random);
+        break;
+      case kTerrain:
+        writeTerrain(writer, faces, seed);
+        break;
+      case kSoup:
+        writeSoup(writer, faces, random);
+        break;
+      default:
+        writeCloud(writer, faces, random);
+        break;
+    }
+  }
+  return size(shape, faces);
+}
+
+MeshGenerator::Size MeshGenerator::writeFile(const std::string &path,
+                                             Shape shape, std::uint64_t faces,
+                                             std::uint64_t seed) {
+  std::ofstream file(path, std::ios::binary);
+  if (!file.is_open()) throw std::invalid_argument("Error writing file");
+  Size result = write(file, shape, faces, seed);
+  file.close();
+  if (!file) throw std::invalid_argument("Error writing file");
+  return result;
+}
+
+std::string MeshGenerator::generate(Shape shape, std::uint64_t faces,
+                                    std::uint64_t seed) {
+  std::ostringstream out{};
+  write(out, shape, faces, seed);
+  return out.str();
+}
+
+MeshGenerator::Shape MeshGenerator::parseShape(const std::string &name) {
+  for (Shape shape : {kSphere, kTerrain, kSoup, kCloud}) {
+    if (name == shapeName(shape)) return shape;
+  }
+  throw std::invalid_argument("Unknown mesh shape: " + name);
+}
+}  // namespace s21
@@ -0,0 +1,97 @@
+#ifndef VIEWER_FRONT_SRC_TOOLS_MESH_GENERATOR_H_
+#define VIEWER_FRONT_SRC_TOOLS_MESH_GENERATOR_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace s21 {
+/**
+ * @brief Генератор синтетических OBJ-моделей для замеров и тестов.
+ *
+ * Модель полностью определяется формой, количеством граней и зерном:
+ * одинаковые параметры дают побайтно одинаковый текст на любой
+ * платформе. Текст пишется потоково, без построения сетки в памяти,
+ * поэтому размер ограничен только диском: от тысяч до сотен миллионов
+ * граней.
+ */
+class MeshGenerator {
+ public:
+  /**
+   * @brief Форма модели.
+   */
+  enum Shape {
+    kSphere,   ///< Сфера из поясов и секторов со слабым шумом радиуса.
+    kTerrain,  ///< Сетка четырёхугольников с шумовым рельефом.
+    kSoup,     ///< Несвязанные треугольники в случайных местах.
+    kCloud     ///< Облако точек без граней.
+  };
+
+  /**
+   * @brief Количество элементов сгенерированной модели.
+   */
+  struct Size {
+    std::uint64_t vertexes;  ///< Количество вершин.
+    std::uint64_t faces;     ///< Количество граней.
+  };
+
+  /**
+   * @brief Вычисляет размер модели без генерации.
+   *
+   * Количество граней подбирается ближайшим, которое допускает форма;
+   * для облака точек faces задаёт количество вершин.
+   *
+   * @param shape Форма.
+   * @param faces Желаемое количество граней.
+   * @return Size Фактическое количество вершин и граней.
+   */
+  static Size size(Shape shape, std::uint64_t faces);
+
+  /**
+   * @brief Пишет модель в поток.
+   *
+   * @param out Поток вывода.
+   * @param shape Форма.
+   * @param faces Желаемое количество граней.
+   * @param seed Зерно генератора случайных чисел.
+   * @return Size Фактическое количество вершин и граней.
+   */
+  static Size write(std::ostream &out, Shape shape, std::uint64_t faces,
+                    std::uint64_t seed);
+
+  /**
+   * @brief Пишет модель в файл.
+   *
+   * @param path Путь к файлу.
+   * @param shape Форма.
+   * @param faces Желаемое количество граней.
+   * @param seed Зерно.
+   * @return Size Фактическое количество вершин и граней.
+   * @throw std::invalid_argument Если файл не удалось записать.
+   */
+  static Size writeFile(const std::string &path, Shape shape,
+                        std::uint64_t faces, std::uint64_t seed);
+
+  /**
+   * @brief Генерирует текст модели в памяти.
+   *
+   * @param shape Форма.
+   * @param faces Желаемое количество граней.
+   * @param seed Зерно.
+   * @return std::string Текст OBJ.
+   */
+  static std::string generate(Shape shape, std::uint64_t faces,
+                              std::uint64_t seed);
+
+  /**
+   * @brief Находит форму по имени (sphere, terrain, soup, cloud).
+   *
+   * @param name Имя формы.
+   * @return Shape Форма.
+   * @throw std::invalid_argument Если имя неизвестно.
+   */
+  static Shape parseShape(const std::string &name);
+};
+}  // namespace s21
+
+#endif  // VIEWER_FRONT_SRC_TOOLS_MESH_GENERATOR_H_
@@ -4,12 +4,19 @@
 #include <QImage>
 #include <vector>
 
+#include "../controller/lod_builder.h"
+#include "../controller/model_loader.h"
 #include "../controller/obj_controller.h"
 #include "QtGifImage/qgifimage.h"
 #include "gl_widget.h"
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 
+namespace {
+/// Модели с меньшим числом треугольников рисуются без упрощения.
+constexpr std::size_t kLodMinTriangles = std::size_t{1} << 18;
+}  // namespace
+
 void MainWindow::on_PushButtonGif_clicked() {  // FIXME
   ui->PushButtonGif->setText("Идёт запись...");
   gif = new QGifImage();
@@ -29,19 +36,88 @@ void MainWindow::on_PushButtonGif_clicked() {  // FIXME
 void MainWindow::slotLoad() {
   QString str = QFileDialog::getOpenFileName();
   if (!str.isEmpty()) {
-    std::shared_ptr<s21::Controller> controllerNewInstance;
-    try {
-      controllerNewInstance =
-          std::make_shared<s21::Controller>(str.toLocal8Bit().data());
-    } catch (std::invalid_argument) {
-      qDebug() << "Fail file parse attempt";
-      return;
-    }
-    ui->openGLWidget->getDataFromFile(controllerNewInstance, str);
-    ui->openGLWidget->resetObject();
-    standartSliderPosition();
+    s21::ParseOptions options;
+    options.useCache = true;
+    // Предыдущая незавершённая загрузка отменяется деструктором загрузчика,
+    // а уже показанная модель остаётся на экране до первых порций новой.
+    loader.reset();
+    ui->openGLWidget->abortStream();
+    loader = std::make_unique<s21::ModelLoader>(str.toLocal8Bit().data(),
+                                                options);
+    loadingFile = str;
+    loadTimer->start(50);
+  }
+}
+
+void MainWindow::slotLoadProgress() {
+  if (!loader) {
+    loadTimer->stop();
+    return;
+  }
+  // Готовность проверяется до выборки порций: после завершения потока
+  // все порции уже опубликованы и будут выбраны целиком.
+  bool done = loader->isFinished();
+  s21::MeshStream &stream = loader->getStream();
+  std::vector<s21::MeshBatch> batches = stream.take();
+  if (!batches.empty()) {
+    if (!ui->openGLWidget->isStreaming())
+      ui->openGLWidget->beginStream(stream.expectedVertexes(),
+                                    stream.expectedIndexes());
+    ui->openGLWidget->appendBatches(std::move(batches));
+  }
+  if (!done) {
+    statusBar()->showMessage(QString("Loading %1: %2%")
+                                 .arg(QFileInfo(loadingFile).fileName())
+                                 .arg(qRound(loader->getProgress() * 100)));
+    return;
+  }
+
+  loadTimer->stop();
+  std::unique_ptr<s21::ModelLoader> finished = std::move(loader);
+  std::shared_ptr<s21::Controller> controllerNewInstance;
+  try {
+    controllerNewInstance = finished->takeResult();
+  } catch (const s21::LoadCancelled &) {
+    ui->openGLWidget->abortStream();
+    statusBar()->showMessage("Loading cancelled", 2000);
+    return;
+  } catch (const std::exception &) {
+    ui->openGLWidget->abortStream();
+    qDebug() << "Fail file parse attempt";
+    statusBar()->showMessage("Fail file parse attempt", 2000);
+    return;
+  }
+  statusBar()->clearMessage();
+  ui->openGLWidget->getDataFromFile(controllerNewInstance, loadingFile);
+  ui->openGLWidget->resetObject();
+  standartSliderPosition();
+  // Уровни прежней модели больше не нужны: её построение отменяется.
+  lodBuilder.reset();
+  if (controllerNewInstance->getEdges().size() / 3 >= kLodMinTriangles) {
+    lodBuilder = std::make_unique<s21::LodBuilder>(controllerNewInstance);
+    lodTimer->start(200);
+  }
+}
+
+void MainWindow::slotLodProgress() {
+  if (!lodBuilder) {
+    lodTimer->stop();
+    return;
+  }
+  if (!lodBuilder->isFinished()) return;
+  lodTimer->stop();
+  std::unique_ptr<s21::LodBuilder> finished = std::move(lodBuilder);
+  try {
+    ui->openGLWidget->setDetailLevels(finished->getModel(),
+                                      finished->takeResult());
+  } catch (const std::exception &) {
+    qDebug() << "Detail levels were not built";
   }
 }
+
+void MainWindow::slotCancelLoad() {
+  if (loader) loader->cancel();
+}
 void MainWindow::saveImage() {
   QImage image;
   QString strPath;
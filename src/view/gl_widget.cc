@@ -1,14 +1,76 @@
 #include "gl_widget.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <sstream>
 #include <string>
 
 #include "../model/camera_model.h"
 
+namespace {
+/// Промежуток между кадрами, после которого кадры не считаются
+/// непрерывными и их время не учитывается при выборе детализации.
+constexpr qint64 kIdleFrameGapMs = 250;
+/// Пауза во вращении или перемещении, после которой модель рисуется
+/// полностью.
+constexpr int kInteractionIdleMs = 200;
+/// Наибольшее количество индексов рёбер, рисуемых во время взаимодействия.
+constexpr std::size_t kProxyIndexes = std::size_t{1} << 21;
+/// Изменение масштаба за один щелчок колеса мыши.
+constexpr float kZoomStep = 1.1f;
+
+/**
+ * @brief Переводит контуры граней, разделённые kPrimitiveRestart, в пары
+ * индексов для GL_LINES, включая замыкающее ребро каждого контура.
+ *
+ * Нужен, когда контекст не поддерживает перезапуск примитива.
+ */
+std::vector<int> outlineSegments(const std::vector<int> &outlines) {
+  std::vector<int> segments;
+  segments.reserve(outlines.size() * 2);
+  std::size_t first = 0;
+  for (std::size_t i = 0; i <= outlines.size(); i++) {
+    if (i < outlines.size() && outlines[i] != s21::kPrimitiveRestart) continue;
+    for (std::size_t j = first; j + 1 < i; j++) {
+      segments.push_back(outlines[j]);
+      segments.push_back(outlines[j + 1]);
+    }
+    if (i - first > 2) {
+      segments.push_back(outlines[i - 1]);
+      segments.push_back(outlines[first]);
+    }
+    first = i + 1;
+  }
+  return segments;
+}
+}  // namespace
+
 GLWidget::GLWidget(QWidget *pwgt /*=0*/) : QOpenGLWidget(pwgt) {
+  VBO = VAO = EBO = 0;
+  shape = nullptr;
   loadedData = false;
   loadedData_2 = false;
+  streaming = false;
+  streamFinishing = false;
+  streamFitted = false;
+  edgePrimitive = GL_LINES;
+  primitiveRestart = false;
+  originScale = sliderScale = wheelZoom = 1.0f;
+  vertexCapacity = indexCapacity = 0;
+  streamedFloats = streamedIndexes = 0;
+  heldMaxIndex = -1;
+  levelsPending = false;
+  interacting = false;
+  proxyArray = proxyBuffer = 0;
+  proxyLines = 0;
+  idleTimer = new QTimer(this);
+  idleTimer->setSingleShot(true);
+  idleTimer->setInterval(kInteractionIdleMs);
+  connect(idleTimer, &QTimer::timeout, this, [this]() {
+    interacting = false;
+    update();
+  });
 }
 
 void GLWidget::GLWidget::resizeEvent(QResizeEvent *event) {
@@ -21,6 +83,47 @@ void GLWidget::GLWidget::resizeEvent(QResizeEvent *event) {
   }
 }
 
+QPointF GLWidget::toDevice(const QPointF &pos) const {
+  return QPointF(2.0 * pos.x() / width() - 1.0,
+                 1.0 - 2.0 * pos.y() / height());
+}
+
+void GLWidget::mousePressEvent(QMouseEvent *event) {
+  lastMouse = toDevice(event->pos());
+  if (event->button() == Qt::LeftButton)
+    camera->beginOrbit(lastMouse.x(), lastMouse.y());
+}
+
+void GLWidget::mouseMoveEvent(QMouseEvent *event) {
+  // Левая кнопка вращает модель, правая или средняя сдвигает её.
+  QPointF point = toDevice(event->pos());
+  if (event->buttons() & Qt::LeftButton) {
+    camera->orbit(point.x(), point.y());
+  } else if (event->buttons() & (Qt::RightButton | Qt::MiddleButton)) {
+    camera->pan(point.x() - lastMouse.x(), point.y() - lastMouse.y());
+    // Ползунки задают сдвиг целиком, поэтому запоминают сдвиг мышью
+    // в тех же координатах центра модели, что и setModelPosition.
+    s21::Vec3f position = camera->getModelPosition();
+    m_xMove = position.x;
+    m_yMove = position.y;
+  } else {
+    return;
+  }
+  lastMouse = point;
+  markInteraction();
+  refreshObject();
+}
+
+void GLWidget::wheelEvent(QWheelEvent *event) {
+  // Один щелчок колеса - 120 единиц angleDelta. Приближение колесом
+  // запоминается отдельно от ползунка, и setScale его не сбрасывает.
+  float factor = std::pow(kZoomStep, event->angleDelta().y() / 120.0f);
+  wheelZoom *= factor;
+  camera->zoom(factor);
+  markInteraction();
+  refreshObject();
+}
+
 void GLWidget::initializeGL() {
   initializeOpenGLFunctions();
   m_program = new QOpenGLShaderProgram;
@@ -53,6 +156,7 @@ void GLWidget::initializeGL() {
   isVertexLocation = m_program->uniformLocation("isVertex");
   drawingModeLocation = m_program->uniformLocation("drawMode");
   lineShapeLocation = m_program->uniformLocation("vertexShape");
+  mvpLocation = m_program->uniformLocation("modelViewProjection");
 
   m_program->bind();
   glUniform4f(colorEdgeUniform, colorEdge.redF(), colorEdge.greenF(),
@@ -63,6 +167,15 @@ void GLWidget::initializeGL() {
 
   m_program->log();
   glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+  // Контуры граней разделяются индексом 0xFFFFFFFF (kPrimitiveRestart).
+  // Фиксированный индекс перезапуска есть только с OpenGL 4.3 и
+  // OpenGL ES 3.0; в более старом контексте разделитель соединял бы
+  // соседние грани, поэтому контуры переводятся в отрезки.
+  QSurfaceFormat format = context()->format();
+  primitiveRestart = context()->isOpenGLES()
+                         ? format.version() >= qMakePair(3, 0)
+                         : format.version() >= qMakePair(4, 3);
+  if (primitiveRestart) glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
 }
 
 void GLWidget::resizeGL(int nWidth, int nHeight) {
@@ -70,6 +183,9 @@ void GLWidget::resizeGL(int nWidth, int nHeight) {
 }
 
 void GLWidget::paintGL() {
+  if (frameClock.isValid() && frameClock.elapsed() < kIdleFrameGapMs)
+    lodSelector.reportFrameTime(frameClock.nsecsElapsed() / 1e6);
+  frameClock.restart();
   QOpenGLFunctions *f = QOpenGLContext::currentContext()->functions();
   f->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
   glClearColor(colorBG.redF(), colorBG.greenF(), colorBG.blueF(),
@@ -83,21 +199,53 @@ void GLWidget::paintGL() {
       loadedData = false;
       setProjectionType(0);
     }
+    if (streaming) uploadBatches();
+    if (levelsPending) uploadLevels();
+
+    GLuint array = VAO;
+    GLenum primitive = edgePrimitive;
+    int lineCount = facest, pointCount = vertexes;
+    bool pointsByLines = false;
+    // Ползунки только помечают матрицы изменёнными; MVP собирается здесь
+    // не чаще раза за кадр.
+    const float *mvp = camera->updateMvp();
+    lodSelector.setInteractive(interacting, kProxyIndexes);
+    std::size_t level = selectLevel();
+    if (level > 0) {
+      array = levelArrays[level - 1];
+      primitive = GL_LINES;
+      lineCount = levelLines[level - 1];
+      pointCount = levelPoints[level - 1];
+    } else if (interacting && levelArrays.empty() && proxyArray != 0 &&
+               !streaming) {
+      // Уровни ещё не построены: пока модель двигают, рисуется каждое
+      // k-е ребро, а точки - только на их концах.
+      array = proxyArray;
+      primitive = GL_LINES;
+      lineCount = proxyLines;
+      pointsByLines = true;
+    }
 
     m_program->bind();
-    m_program->setUniformValue("modelViewProjection", m_projection);
+    // MVP хранится по строкам, поэтому загружается с транспонированием
+    // без промежуточной QMatrix4x4.
+    glUniformMatrix4fv(mvpLocation, 1, GL_TRUE, mvp);
 
-    glBindVertexArray(VAO);
+    glBindVertexArray(array);
     glUniform1i(isVertexLocation, 0);
     glUniform1i(drawingModeLocation, drawingMode);
     glLineWidth(this->edgeSize);
-    glDrawElements(GL_TRIANGLES, facest, GL_UNSIGNED_INT, 0);
+    glDrawElements(primitive, lineCount, GL_UNSIGNED_INT, 0);
 
     glUniform1i(isVertexLocation, 1);
     glUniform1i(lineShapeLocation, vertexShape);
     glPointSize(vertexSize);
     if (vertexShape == 1) ::glEnable(GL_POINT_SMOOTH);
-    glDrawArrays(GL_POINTS, 0, vertexes);
+    if (pointsByLines) {
+      glDrawElements(GL_POINTS, lineCount, GL_UNSIGNED_INT, 0);
+    } else {
+      glDrawArrays(GL_POINTS, 0, pointCount);
+    }
     if (vertexShape == 1) ::glDisable(GL_POINT_SMOOTH);
 
     glBindVertexArray(0);
@@ -122,37 +270,353 @@ void GLWidget::createObject(s21::Controller *openedShape) {
   glEnableVertexAttribArray(0);  // Enable the position attribute
 
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-               sizeof(unsigned int) * openedShape->getFacetsCount(),
-               openedShape->getEdges().data(), GL_STATIC_DRAW);
+  glBindVertexArray(0);
+  uploadLines(openedShape);
+}
+
+void GLWidget::uploadLines(s21::Controller *openedShape) {
+  // Каркас рисуется отрезками по уникальным рёбрам контуров: общее ребро
+  // соседних граней растеризуется один раз, а диагонали триангуляции не
+  // рисуются вовсе.
+  const std::vector<int> &lines = openedShape->getLines();
+  indexCapacity =
+      static_cast<GLsizeiptr>(lines.size() * sizeof(unsigned int));
+  glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+  glBufferData(GL_COPY_WRITE_BUFFER, indexCapacity, lines.data(),
+               GL_STATIC_DRAW);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  facest = static_cast<int>(lines.size());
+  edgePrimitive = GL_LINES;
+  uploadProxy(lines);
+}
 
+void GLWidget::uploadProxy(const std::vector<int> &lines) {
+  if (proxyArray) {
+    glDeleteVertexArrays(1, &proxyArray);
+    glDeleteBuffers(1, &proxyBuffer);
+    proxyArray = proxyBuffer = 0;
+  }
+  proxyLines = 0;
+  if (lines.size() <= kProxyIndexes) return;
+  // Прореженные рёбра ссылаются на вершины полной модели, поэтому
+  // буфер вершин общий, а свой только буфер индексов.
+  std::vector<int> sampled =
+      s21::LodSelector::strideLines(lines, kProxyIndexes);
+  glGenVertexArrays(1, &proxyArray);
+  glGenBuffers(1, &proxyBuffer);
+  glBindVertexArray(proxyArray);
+  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float),
+                        (GLvoid *)0);
+  glEnableVertexAttribArray(0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, proxyBuffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+               static_cast<GLsizeiptr>(sampled.size() * sizeof(unsigned int)),
+               sampled.data(), GL_STATIC_DRAW);
   glBindVertexArray(0);
+  proxyLines = static_cast<int>(sampled.size());
 }
 
 void GLWidget::getDataFromFile(std::shared_ptr<s21::Controller> model,
                                QString str) {
   this->model = model;
   shape = model.get();
-  vertexes = shape->getVertexCount();
-  facest = shape->getFacetsCount();
-  loadedData = true;
+  // Уровни прежней модели больше не годятся, даже если буферы самой
+  // модели остаются от потоковой загрузки.
+  detailLevels.clear();
+  levelsPending = false;
+  makeCurrent();
+  cleanupLevels();
+  doneCurrent();
+  if (streaming && streamedFloats == shape->getVertexes().size() &&
+      streamedIndexes == shape->getOutlines().size()) {
+    // Модель уже целиком передана порциями: буферы остаются прежними,
+    // paintGL дозагрузит последние порции.
+    streamFinishing = true;
+  } else {
+    streaming = false;
+    pendingBatches.clear();
+    heldEdges.clear();
+    vertexes = shape->getVertexCount();
+    facest = static_cast<int>(shape->getLines().size());
+    edgePrimitive = GL_LINES;
+    loadedData = true;
+  }
   loadedData_2 = true;
   setFileInfo(str);
   update();
 }
 
+void GLWidget::beginStream(std::size_t expectedVertexes,
+                           std::size_t expectedIndexes) {
+  // Буферы создаются в paintGL, где активен контекст OpenGL; размер
+  // берётся по оценке из размера файла, чтобы порции дописывались через
+  // glBufferSubData без перевыделения.
+  makeCurrent();
+  cleanup();
+  doneCurrent();
+  streaming = true;
+  streamFinishing = false;
+  streamFitted = false;
+  vertexCapacity =
+      static_cast<GLsizeiptr>(expectedVertexes * 3 * sizeof(float));
+  indexCapacity =
+      static_cast<GLsizeiptr>(expectedIndexes * sizeof(unsigned int));
+  streamedFloats = streamedIndexes = 0;
+  pendingBatches.clear();
+  heldEdges.clear();
+  heldMaxIndex = -1;
+  streamBounds = s21::BoundingBox{};
+  vertexes = 0;
+  facest = 0;
+  // До конца загрузки уникальные рёбра неизвестны, и порции рисуются
+  // контурами граней с перезапуском примитива либо их отрезками.
+  edgePrimitive = primitiveRestart ? GL_LINE_LOOP : GL_LINES;
+  loadedData = false;
+  loadedData_2 = true;
+  update();
+}
+
+void GLWidget::appendBatches(std::vector<s21::MeshBatch> batches) {
+  for (s21::MeshBatch &batch : batches) {
+    streamedFloats += batch.vertexes.size();
+    streamedIndexes += batch.outlines.size();
+    pendingBatches.push_back(std::move(batch));
+  }
+  update();
+}
+
+void GLWidget::abortStream() {
+  if (!streaming) return;
+  streaming = false;
+  streamFinishing = false;
+  pendingBatches.clear();
+  heldEdges.clear();
+  if (shape != nullptr) {
+    // Возвращается модель, показанная до начала загрузки.
+    vertexes = shape->getVertexCount();
+    facest = static_cast<int>(shape->getLines().size());
+    edgePrimitive = GL_LINES;
+    loadedData = true;
+  } else {
+    loadedData_2 = false;
+  }
+  update();
+}
+
+bool GLWidget::isStreaming() const { return streaming; }
+
+void GLWidget::setDetailLevels(const std::shared_ptr<s21::Controller> &owner,
+                               std::vector<s21::MeshLod> levels) {
+  // Уровни, построенные для уже закрытой модели, отбрасываются.
+  if (owner != model) return;
+  // Буферы уровней создаются в paintGL, где активен контекст OpenGL.
+  detailLevels = std::move(levels);
+  levelsPending = true;
+  QString info = filename;
+  info.append(" levels:");
+  for (const s21::MeshLod &level : detailLevels)
+    info.append(' ').append(QString::number(level.triangles.size() / 3));
+  setStatusTip(info);
+  update();
+}
+
+void GLWidget::uploadLevels() {
+  cleanupLevels();
+  std::vector<float> errors{0.0f};
+  for (const s21::MeshLod &level : detailLevels) {
+    // У каждого уровня свои сжатые вершины и рёбра, поэтому и свой VAO.
+    GLuint array = 0, buffers[2] = {0, 0};
+    glGenVertexArrays(1, &array);
+    glGenBuffers(2, buffers);
+    glBindVertexArray(array);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(level.vertexes.size() * sizeof(float)),
+                 level.vertexes.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float),
+                          (GLvoid *)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+    glBufferData(
+        GL_ELEMENT_ARRAY_BUFFER,
+        static_cast<GLsizeiptr>(level.lines.size() * sizeof(unsigned int)),
+        level.lines.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+    levelArrays.push_back(array);
+    levelBuffers.insert(levelBuffers.end(), buffers, buffers + 2);
+    levelLines.push_back(static_cast<int>(level.lines.size()));
+    levelPoints.push_back(static_cast<int>(level.vertexes.size() / 3));
+    errors.push_back(level.error);
+  }
+  std::vector<std::size_t> sizes{static_cast<std::size_t>(facest)};
+  sizes.insert(sizes.end(), levelLines.begin(), levelLines.end());
+  lodSelector.setLevels(std::move(errors), std::move(sizes));
+  // Данные уровней уже в видеопамяти, копии в памяти процесса не нужны.
+  std::vector<s21::MeshLod>().swap(detailLevels);
+  levelsPending = false;
+}
+
+std::size_t GLWidget::selectLevel() {
+  if (levelArrays.empty() || streaming || shape == nullptr) return 0;
+  float radius = shape->getRadius();
+  if (!(radius > 0.0f)) return 0;
+  const float center[3] = {shape->getCenterX(), shape->getCenterY(),
+                           shape->getCenterZ()};
+  float pixels = s21::LodSelector::projectedRadius(
+      camera->getMvpMatrix(), center, radius,
+      static_cast<int>(height() * devicePixelRatioF()));
+  return lodSelector.select(pixels / radius);
+}
+
+void GLWidget::uploadBatches() {
+  if (VAO == 0) {
+    cleanup();
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertexCapacity, nullptr, GL_DYNAMIC_DRAW);
+    // Буфер индексов привязывается к VAO ниже, после загрузки порций.
+    glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, indexCapacity, nullptr,
+                 GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  }
+
+  bool grown = false;
+  for (const s21::MeshBatch &batch : pendingBatches) {
+    GLsizeiptr used = static_cast<GLsizeiptr>(vertexes) * 3 * sizeof(float);
+    GLsizeiptr size =
+        static_cast<GLsizeiptr>(batch.vertexes.size() * sizeof(float));
+    reserveBuffer(VBO, vertexCapacity, used, used + size);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferSubData(GL_ARRAY_BUFFER, used, size, batch.vertexes.data());
+    vertexes += static_cast<int>(batch.vertexes.size() / 3);
+
+    // Индексы придерживаются, пока не загружены вершины, на которые они
+    // ссылаются, иначе контуры тянулись бы к мусору в буфере.
+    heldEdges.insert(heldEdges.end(), batch.outlines.begin(),
+                     batch.outlines.end());
+    for (int index : batch.outlines)
+      heldMaxIndex = std::max(heldMaxIndex, index);
+    for (int axis = 0; axis < 3; axis++) {
+      if (batch.min[axis] < streamBounds.min[axis] ||
+          batch.max[axis] > streamBounds.max[axis])
+        grown = true;
+    }
+    streamBounds.merge(s21::BoundingBox{
+        {batch.min[0], batch.min[1], batch.min[2]},
+        {batch.max[0], batch.max[1], batch.max[2]}});
+  }
+  pendingBatches.clear();
+  if (streamFinishing) {
+    heldEdges.clear();
+    heldMaxIndex = -1;
+    uploadLines(shape);
+  } else if (heldMaxIndex < vertexes) {
+    uploadHeldEdges();
+  }
+
+  glBindVertexArray(VAO);
+  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float),
+                        (GLvoid *)0);
+  glEnableVertexAttribArray(0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+  glBindVertexArray(0);
+
+  if (grown && vertexes > 0) {
+    // Границы известны только для разобранной части: вписывание модели
+    // уточняется с каждой порцией, расширившей их в любую сторону.
+    camera->calculateModelMatrix(
+        s21::Vec3f{streamBounds.min[0], streamBounds.min[1],
+                   streamBounds.min[2]},
+        s21::Vec3f{streamBounds.max[0], streamBounds.max[1],
+                   streamBounds.max[2]});
+    if (!streamFitted) {
+      initView();
+      streamFitted = true;
+    } else {
+      originScale = camera->getModelMatrix()[0];
+      camera->setModelScale(sliderScale * wheelZoom * originScale);
+    }
+  }
+  if (streamFinishing) {
+    streaming = false;
+    streamFinishing = false;
+  }
+}
+
+void GLWidget::uploadHeldEdges() {
+  if (heldEdges.empty()) return;
+  if (!primitiveRestart) heldEdges = outlineSegments(heldEdges);
+  GLsizeiptr used = static_cast<GLsizeiptr>(facest) * sizeof(unsigned int);
+  GLsizeiptr size =
+      static_cast<GLsizeiptr>(heldEdges.size() * sizeof(unsigned int));
+  reserveBuffer(EBO, indexCapacity, used, used + size);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+  glBufferSubData(GL_COPY_WRITE_BUFFER, used, size, heldEdges.data());
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  facest += static_cast<int>(heldEdges.size());
+  heldEdges.clear();
+  heldMaxIndex = -1;
+}
+
+void GLWidget::reserveBuffer(GLuint &buffer, GLsizeiptr &capacity,
+                             GLsizeiptr used, GLsizeiptr needed) {
+  if (needed <= capacity) return;
+  // Оценка по размеру файла оказалась мала: буфер перевыделяется с
+  // запасом, уже загруженные данные копируются на стороне GPU.
+  GLsizeiptr grown = std::max(needed, capacity * 2);
+  GLuint replacement = 0;
+  glGenBuffers(1, &replacement);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, replacement);
+  glBufferData(GL_COPY_WRITE_BUFFER, grown, nullptr, GL_DYNAMIC_DRAW);
+  if (used > 0) {
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, used);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  glDeleteBuffers(1, &buffer);
+  buffer = replacement;
+  capacity = grown;
+}
+
 void GLWidget::setFileInfo(QString str) {
   QFileInfo fileInfo(str);
   filename = fileInfo.fileName();
   filename.append(" vertices: ");
-  filename.append(QString::number(vertexes));
+  filename.append(QString::number(shape->getVertexCount()));
   filename.append(" facets: ");
-  filename.append(QString::number(facest));
+  filename.append(QString::number(shape->getFacetsCount()));
 
   setStatusTip(filename);
 }
 
+void GLWidget::cleanupLevels() {
+  if (!levelArrays.empty()) {
+    glDeleteVertexArrays(static_cast<GLsizei>(levelArrays.size()),
+                         levelArrays.data());
+    glDeleteBuffers(static_cast<GLsizei>(levelBuffers.size()),
+                    levelBuffers.data());
+  }
+  levelArrays.clear();
+  levelBuffers.clear();
+  levelLines.clear();
+  levelPoints.clear();
+  lodSelector.setLevels({});
+}
+
 void GLWidget::cleanup() {
+  cleanupLevels();
+  if (proxyArray) {
+    glDeleteVertexArrays(1, &proxyArray);
+    glDeleteBuffers(1, &proxyBuffer);
+    proxyArray = proxyBuffer = 0;
+  }
+  proxyLines = 0;
   if (VAO) {
     glDeleteVertexArrays(1, &VAO);
     VAO = 0;  // Reset to 0 after deletion
@@ -169,6 +633,10 @@ void GLWidget::cleanup() {
 
 void GLWidget::initMvp(s21::Controller *shape) {
   camera->calculateModelMatrix(shape);
+  initView();
+}
+
+void GLWidget::initView() {
   originScale = camera->getModelMatrix()[0];
   camera->calculateViewMatrix();
 
@@ -182,21 +650,6 @@ void GLWidget::initMvp(s21::Controller *shape) {
       break;
   }
   camera->calculateRotationMatrix(0, 0, 0);
-  camera->multModelRotation();
-  camera->multMvpView();
-  camera->multMvpProjection();
-  m_projection = adjustModelMatrix(camera->getMvpMatrix());
-}
-
-QMatrix4x4 GLWidget::adjustModelMatrix(float *modelMatrix) {
-  QMatrix4x4 qtModelMatrix;
-
-  for (int row = 0; row < 4; ++row) {
-    for (int col = 0; col < 4; ++col) {
-      qtModelMatrix(row, col) = modelMatrix[row * 4 + col];
-    }
-  }
-  return qtModelMatrix;
 }
 
 void GLWidget::setBgColor(QColor color) {
@@ -258,6 +711,7 @@ void GLWidget::setRotateX(float rotation) {
   m_zRotate = rotation;
 
   camera->calculateRotationMatrix(m_xRotate, m_yRotate, m_zRotate);
+  markInteraction();
   refreshObject();
 }
 
@@ -265,6 +719,7 @@ void GLWidget::setRotateY(float rotation) {
   m_yRotate = rotation;
 
   camera->calculateRotationMatrix(m_xRotate, m_yRotate, m_zRotate);
+  markInteraction();
   refreshObject();
 }
 
@@ -272,6 +727,7 @@ void GLWidget::setRotateZ(float rotation) {
   m_xRotate = rotation;
 
   camera->calculateRotationMatrix(m_xRotate, m_yRotate, m_zRotate);
+  markInteraction();
   refreshObject();
 }
 
@@ -279,6 +735,7 @@ void GLWidget::setMoveX(float move) {
   m_xMove = move;
 
   camera->setModelPosition(m_xMove, m_yMove, m_zMove);
+  markInteraction();
   refreshObject();
 }
 
@@ -286,6 +743,7 @@ void GLWidget::setMoveY(float move) {
   m_yMove = move;
 
   camera->setModelPosition(m_xMove, m_yMove, m_zMove);
+  markInteraction();
   refreshObject();
 }
 
@@ -293,14 +751,24 @@ void GLWidget::setMoveZ(float move) {
   m_zMove = move;
 
   camera->setModelPosition(m_xMove, m_yMove, m_zMove);
+  markInteraction();
   refreshObject();
 }
 
 void GLWidget::setScale(float scale) {
-  camera->setModelScale(scale * originScale);
+  sliderScale = scale;
+  camera->setModelScale(sliderScale * wheelZoom * originScale);
+  markInteraction();
   refreshObject();
 }
 
+void GLWidget::markInteraction() {
+  // Таймер перезапускается при каждом сдвиге ползунка; полная детализация
+  // возвращается, когда модель перестают двигать.
+  interacting = true;
+  idleTimer->start();
+}
+
 void GLWidget::setProjectionType(int type) {
   projection_type = type;
   switch (projection_type) {
@@ -316,19 +784,14 @@ void GLWidget::setProjectionType(int type) {
 }
 
 void GLWidget::resetObject() {
-  camera->setModelScale(originScale);
+  wheelZoom = 1.0f;
+  camera->setModelScale(sliderScale * originScale);
   camera->setModelPosition(0, 0, 0);
   camera->calculateRotationMatrix(0, 0, 0);
   refreshObject();
 }
 
-void GLWidget::refreshObject() {
-  camera->multModelRotation();
-  camera->multMvpView();
-  camera->multMvpProjection();
-  m_projection = adjustModelMatrix(camera->getMvpMatrix());
-  update();
-}
+void GLWidget::refreshObject() { update(); }
 
 void GLWidget::updateBgColor(QColor color) { setBgColor(color); }
 
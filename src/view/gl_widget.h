@@ -6,8 +6,12 @@
 #include <QtWidgets>
 
 #include "../controller/camera_controller.h"
+#include "../controller/lod_selector.h"
 #include "../controller/obj_controller.h"
+#include "../model/bounding_box.h"
 #include "../model/camera_model.h"
+#include "../model/mesh_simplifier.h"
+#include "../model/mesh_stream.h"
 #include "../model/obj_model.h"
 
 class GLWidget : public QOpenGLWidget, protected QOpenGLExtraFunctions {
@@ -15,15 +19,16 @@ class GLWidget : public QOpenGLWidget, protected QOpenGLExtraFunctions {
  private:
   GLuint VBO, VAO, EBO;
   QOpenGLShaderProgram *m_program;
-  QMatrix4x4 m_projection;
   int projection_type, drawingMode, vertexShape;
   float vertexSize, edgeSize;
   float originScale;
+  float sliderScale, wheelZoom;
   GLint colorEdgeUniform;
   GLint colorVertexUniform;
   GLint isVertexLocation;
   GLint lineShapeLocation;
   GLint drawingModeLocation;
+  GLint mvpLocation;
   float m_xRotate, m_yRotate, m_zRotate;
   float m_xMove, m_yMove, m_zMove;
   std::shared_ptr<s21::Controller> model;
@@ -31,8 +36,30 @@ class GLWidget : public QOpenGLWidget, protected QOpenGLExtraFunctions {
   QString filename;
   int vertexes;
   int facest;
+  GLenum edgePrimitive;
+  bool primitiveRestart;
   bool loadedData;
   bool loadedData_2;
+  bool streaming;
+  bool streamFinishing;
+  bool streamFitted;
+  GLsizeiptr vertexCapacity, indexCapacity;
+  std::size_t streamedFloats, streamedIndexes;
+  std::vector<s21::MeshBatch> pendingBatches;
+  std::vector<int> heldEdges;
+  std::vector<s21::MeshLod> detailLevels;
+  bool levelsPending;
+  std::vector<GLuint> levelArrays, levelBuffers;
+  std::vector<int> levelLines, levelPoints;
+  s21::LodSelector lodSelector;
+  QElapsedTimer frameClock;
+  QTimer *idleTimer;
+  bool interacting;
+  GLuint proxyArray, proxyBuffer;
+  int proxyLines;
+  QPointF lastMouse;
+  int heldMaxIndex;
+  s21::BoundingBox streamBounds;
 
   QColor colorBG;
   QColor colorVertex;
@@ -44,12 +71,26 @@ class GLWidget : public QOpenGLWidget, protected QOpenGLExtraFunctions {
   virtual void resizeGL(int nWidth, int nHeight);
   virtual void paintGL();
   void createObject(s21::Controller *shape);
-  QMatrix4x4 adjustModelMatrix(float *modelMatrix);
   void cleanup();
+  void cleanupLevels();
+  void uploadLevels();
+  std::size_t selectLevel();
   void initMvp(s21::Controller *shape);
+  void initView();
+  void uploadBatches();
+  void uploadHeldEdges();
+  void uploadLines(s21::Controller *openedShape);
+  void uploadProxy(const std::vector<int> &lines);
+  void markInteraction();
+  void reserveBuffer(GLuint &buffer, GLsizeiptr &capacity, GLsizeiptr used,
+                     GLsizeiptr needed);
   void refreshObject();
   void setFileInfo(QString str);
   virtual void resizeEvent(QResizeEvent *event) Q_DECL_OVERRIDE;
+  virtual void mousePressEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
+  virtual void mouseMoveEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
+  virtual void wheelEvent(QWheelEvent *event) Q_DECL_OVERRIDE;
+  QPointF toDevice(const QPointF &pos) const;
 
  public:
   GLWidget(QWidget *pwgt = 0);
@@ -76,6 +117,12 @@ class GLWidget : public QOpenGLWidget, protected QOpenGLExtraFunctions {
   void setScale(float scale);
   void setProjectionType(int type);
   void resetObject();
+  void beginStream(std::size_t expectedVertexes, std::size_t expectedIndexes);
+  void appendBatches(std::vector<s21::MeshBatch> batches);
+  void abortStream();
+  void setDetailLevels(const std::shared_ptr<s21::Controller> &owner,
+                       std::vector<s21::MeshLod> levels);
+  bool isStreaming() const;
   s21::CameraController *camera;
 
  public slots:
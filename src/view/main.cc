@@ -1,8 +1,17 @@
 #include <QApplication>
+#include <QSurfaceFormat>
 
 #include "mainwindow.h"
 
 int main(int argc, char *argv[]) {
+  // Контуры граней при загрузке рисуются с фиксированным индексом
+  // перезапуска примитива из OpenGL 4.3. Профиль совместимости нужен
+  // шейдерам без #version; если контекст 4.3 недоступен, GLWidget рисует
+  // контуры отрезками.
+  QSurfaceFormat format = QSurfaceFormat::defaultFormat();
+  format.setVersion(4, 3);
+  format.setProfile(QSurfaceFormat::CompatibilityProfile);
+  QSurfaceFormat::setDefaultFormat(format);
   QApplication app(argc, argv);
 
   s21::CameraController &camera = s21::CameraController::getInstance();
@@ -14,7 +14,6 @@
 
 MainWindow::MainWindow(s21::CameraController *camera, QWidget *parent)
     : QMainWindow(parent), ui(new Ui::MainWindow), camera_(camera) {
-  setlocale(LC_ALL, "C");
   ui->setupUi(this);
   ui->openGLWidget->camera = camera_;
   statusBar()->showMessage("Ready", 2000);
@@ -23,6 +22,13 @@ MainWindow::MainWindow(s21::CameraController *camera, QWidget *parent)
 
   pmnuFile->addAction("&Open...", QKeySequence("CTRL+O"), this,
                       &MainWindow::slotLoad);
+  pmnuFile->addAction("&Cancel loading", QKeySequence("Esc"), this,
+                      &MainWindow::slotCancelLoad);
+
+  loadTimer = new QTimer(this);
+  connect(loadTimer, &QTimer::timeout, this, &MainWindow::slotLoadProgress);
+  lodTimer = new QTimer(this);
+  connect(lodTimer, &QTimer::timeout, this, &MainWindow::slotLodProgress);
 
   pmnuFile->addSeparator();
   pmnuFile->addAction("&Quit", QKeySequence("CTRL+Q"), qApp,
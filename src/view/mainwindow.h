@@ -4,7 +4,10 @@
 #include <QMainWindow>
 #include <QSettings>
 #include <QTimer>
+#include <memory>
 
+#include "../controller/lod_builder.h"
+#include "../controller/model_loader.h"
 #include "QtGifImage/qgifimage.h"
 #include "gl_widget.h"
 
@@ -28,6 +31,9 @@ class MainWindow : public QMainWindow {
 
  private slots:
   void slotLoad();
+  void slotLoadProgress();
+  void slotCancelLoad();
+  void slotLodProgress();
   void on_PushButtonBgColor_clicked();
   void on_PushButtonEdgeColor_clicked();
   void on_PushButtonVertexColor_clicked();
@@ -59,7 +65,12 @@ class MainWindow : public QMainWindow {
   QGifImage *gif;
   QTimer *timer;
   QTimer *screenTimer;
+  QTimer *loadTimer;
+  QTimer *lodTimer;
   QImage screen;
+  QString loadingFile;
+  std::unique_ptr<s21::ModelLoader> loader;
+  std::unique_ptr<s21::LodBuilder> lodBuilder;
   void standartSliderPosition();
   s21::CameraController *camera_;
 };